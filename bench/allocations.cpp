@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+
+#include "../src/pool.h"
+#include "common.h"
+
+using namespace Byte::ECS;
+
+struct Health
+{
+	int value;
+};
+
+struct Enemy
+{
+};
+
+class CountingResource : public std::pmr::memory_resource
+{
+private:
+	std::pmr::memory_resource* upstream;
+
+public:
+	size_t allocations{ 0 };
+	size_t deallocations{ 0 };
+	size_t bytes{ 0 };
+
+public:
+	CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+		:upstream{ upstream }
+	{
+	}
+
+private:
+	void* do_allocate(size_t size, size_t alignment) override
+	{
+		++allocations;
+		bytes += size;
+		return upstream->allocate(size, alignment);
+	}
+
+	void do_deallocate(void* pointer, size_t size, size_t alignment) override
+	{
+		++deallocations;
+		upstream->deallocate(pointer, size, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
+void simulate(std::pmr::memory_resource* resource, size_t count)
+{
+	Pool pool{ resource };
+	std::vector<EntityID> ids;
+	ids.reserve(count);
+
+	for (size_t index{}; index < count; ++index)
+	{
+		ids.push_back(pool.create(Position{}, Velocity{}));
+	}
+
+	for (size_t index{}; index < count; index += 3)
+	{
+		pool.attach(ids[index], Health{ 100 });
+	}
+
+	for (size_t index{}; index < count; index += 5)
+	{
+		pool.attach(ids[index], Enemy{});
+	}
+
+	pool.apply<Position, const Velocity>([](Position& position, const Velocity& velocity)
+		{
+			position.x += velocity.x;
+		});
+
+	for (size_t index{}; index < count; index += 2)
+	{
+		pool.destroy(ids[index]);
+	}
+}
+
+void run(const char* name, CountingResource& counter, std::pmr::memory_resource* resource, size_t count)
+{
+	double elapsed{ measure(1, [&]() { simulate(resource, count); }) };
+
+	std::printf("%-12s %12zu %12zu %14zu %10.3f\n", name, counter.allocations, counter.deallocations, counter.bytes, elapsed);
+}
+
+int main(int argc, char** argv)
+{
+	size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t{ 100000 } };
+
+	std::printf("entities %zu\n", count);
+	std::printf("%-12s %12s %12s %14s %10s\n", "resource", "allocations", "frees", "bytes", "ms");
+
+	{
+		CountingResource counter;
+		run("heap", counter, &counter, count);
+	}
+
+	{
+		CountingResource counter;
+		{
+			MonotonicMemory memory{ MonotonicMemory::DEFAULT_SIZE, &counter };
+			run("monotonic", counter, memory, count);
+		}
+	}
+
+	{
+		CountingResource counter;
+		{
+			PooledMemory memory{ PooledMemory::DEFAULT_BLOCK, &counter };
+			run("pooled", counter, memory, count);
+		}
+	}
+
+	return 0;
+}
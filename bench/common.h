@@ -0,0 +1,32 @@
+#ifndef BYTE_ECS_BENCH_COMMON_H
+#define BYTE_ECS_BENCH_COMMON_H
+
+#include <chrono>
+#include <cstddef>
+#include <algorithm>
+
+struct Position
+{
+	float x, y, z;
+};
+
+struct Velocity
+{
+	float x, y, z;
+};
+
+template<typename Callable>
+double measure(size_t repeats, const Callable& callable)
+{
+	double best{ 1e30 };
+	for (size_t repeat{}; repeat < repeats; ++repeat)
+	{
+		auto begin{ std::chrono::steady_clock::now() };
+		callable();
+		auto end{ std::chrono::steady_clock::now() };
+		best = std::min(best, std::chrono::duration<double, std::milli>(end - begin).count());
+	}
+	return best;
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+
+#include "../src/pool.h"
+#include "common.h"
+
+using namespace Byte::ECS;
+
+struct Player
+{
+};
+
+struct Enemy
+{
+};
+
+void populate(Pool& pool, size_t count)
+{
+	auto initializer{ [](EntityID, Position& position, Velocity& velocity, auto&...)
+		{
+			position = Position{ 1.0f, 2.0f, 3.0f };
+			velocity = Velocity{ 0.5f, 0.25f, 0.125f };
+		} };
+
+	pool.createMany<Position, Velocity>(count / 2, initializer);
+	pool.createMany<Position, Velocity, Player>(count / 4, initializer);
+	pool.createMany<Position, Velocity, Enemy>(count / 4, initializer);
+}
+
+void run(const char* name, ClusterStorage storage, size_t count, size_t repeats)
+{
+	Pool pool{ storage };
+	populate(pool, count);
+
+	double tuple{ measure(repeats, [&]()
+		{
+			for (auto [position, velocity] : pool.components<Position, const Velocity>())
+			{
+				position.x += velocity.x;
+				position.y += velocity.y;
+				position.z += velocity.z;
+			}
+		}) };
+
+	double chunk{ measure(repeats, [&]()
+		{
+			pool.components<Position, const Velocity>().eachChunk([](std::span<Position> positions, std::span<const Velocity> velocities)
+				{
+					for (size_t index{}; index < positions.size(); ++index)
+					{
+						positions[index].x += velocities[index].x;
+						positions[index].y += velocities[index].y;
+						positions[index].z += velocities[index].z;
+					}
+				});
+		}) };
+
+	double tupleID{ measure(repeats, [&]()
+		{
+			for (auto [id, position, velocity] : pool.componentsWithID<Position, const Velocity>())
+			{
+				position.x += velocity.x + static_cast<float>(id & 1);
+			}
+		}) };
+
+	double chunkID{ measure(repeats, [&]()
+		{
+			pool.componentsWithID<Position, const Velocity>().eachChunk([](std::span<const EntityID> ids, std::span<Position> positions, std::span<const Velocity> velocities)
+				{
+					for (size_t index{}; index < positions.size(); ++index)
+					{
+						positions[index].x += velocities[index].x + static_cast<float>(ids[index] & 1);
+					}
+				});
+		}) };
+
+	std::printf("%-12s %-10s %12.3f %12.3f %10.2f\n", name, "View", tuple, chunk, tuple / chunk);
+	std::printf("%-12s %-10s %12.3f %12.3f %10.2f\n", name, "IDView", tupleID, chunkID, tupleID / chunkID);
+}
+
+int main(int argc, char** argv)
+{
+	size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t{ 1 } << 22 };
+	constexpr size_t repeats{ 10 };
+
+	std::printf("entities %zu\n", count);
+	std::printf("%-12s %-10s %12s %12s %10s\n", "storage", "view", "tuple ms", "chunk ms", "speedup");
+	run("contiguous", ClusterStorage::CONTIGUOUS, count, repeats);
+	run("chunked", ClusterStorage::CHUNKED, count, repeats);
+
+	return 0;
+}
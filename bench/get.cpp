@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <random>
+
+#include "../src/pool.h"
+#include "common.h"
+
+using namespace Byte::ECS;
+
+struct Health
+{
+	int value;
+};
+
+struct Enemy
+{
+};
+
+std::vector<EntityID> populate(Pool& pool, size_t count)
+{
+	std::vector<EntityID> out;
+	out.reserve(count);
+
+	for (size_t index{}; index < count; ++index)
+	{
+		Position position{ static_cast<float>(index), 0.0f, 0.0f };
+		switch (index % 4)
+		{
+		case 0:
+			out.push_back(pool.create(position));
+			break;
+		case 1:
+			out.push_back(pool.create(position, Velocity{}));
+			break;
+		case 2:
+			out.push_back(pool.create(position, Velocity{}, Health{ 100 }));
+			break;
+		default:
+			out.push_back(pool.create(position, Health{ 100 }, Enemy{}));
+			break;
+		}
+	}
+	return out;
+}
+
+void run(const char* name, ClusterStorage storage, size_t count, size_t lookups, size_t repeats)
+{
+	Pool pool{ storage };
+	std::vector<EntityID> ids{ populate(pool, count) };
+
+	std::mt19937_64 random{ 42 };
+	std::uniform_int_distribution<size_t> pick{ 0, count - 1 };
+	std::vector<EntityID> order(lookups);
+	for (auto& id : order)
+	{
+		id = ids[pick(random)];
+	}
+
+	float sum{ 0.0f };
+	double read{ measure(repeats, [&]()
+		{
+			for (auto id : order)
+			{
+				sum += pool.get<const Position>(id).x;
+			}
+		}) };
+
+	double write{ measure(repeats, [&]()
+		{
+			for (auto id : order)
+			{
+				pool.get<Position>(id).y += 1.0f;
+			}
+		}) };
+
+	std::printf("%-12s %10zu %12.3f %12.2f %12.3f %12.2f\n", name, count,
+		read, read * 1e6 / static_cast<double>(lookups), write, write * 1e6 / static_cast<double>(lookups));
+
+	if (sum < 0.0f)
+	{
+		std::printf("%f\n", sum);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	size_t lookups{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t{ 1'000'000 } };
+	constexpr size_t repeats{ 5 };
+
+	std::printf("lookups %zu\n", lookups);
+	std::printf("%-12s %10s %12s %12s %12s %12s\n", "storage", "entities", "read ms", "read ns", "write ms", "write ns");
+
+	for (size_t count : { size_t{ 1'000 }, size_t{ 100'000 } })
+	{
+		run("contiguous", ClusterStorage::CONTIGUOUS, count, lookups, repeats);
+		run("chunked", ClusterStorage::CHUNKED, count, lookups, repeats);
+	}
+
+	return 0;
+}
@@ -0,0 +1,52 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+
+#include "../src/pool.h"
+#include "common.h"
+
+using namespace Byte::ECS;
+
+struct Frozen
+{
+};
+
+void integrate(Position& position, const Velocity& velocity)
+{
+	position.x += velocity.x * 0.016f + std::sin(position.y) * 0.001f;
+	position.y += velocity.y * 0.016f + std::cos(position.z) * 0.001f;
+	position.z += velocity.z * 0.016f + std::sin(position.x) * 0.001f;
+}
+
+int main(int argc, char** argv)
+{
+	size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t{ 1 } << 21 };
+	size_t maxThreads{ std::max<size_t>(std::thread::hardware_concurrency(), 1) };
+	constexpr size_t repeats{ 5 };
+
+	Pool pool;
+	pool.createMany<Position, Velocity>(count, [](EntityID, Position& position, Velocity& velocity)
+		{
+			position = Position{ 1.0f, 2.0f, 3.0f };
+			velocity = Velocity{ 0.5f, 0.25f, 0.125f };
+		});
+
+	// A small second cluster checks that uneven cluster sizes still balance.
+	pool.createMany<Position, Velocity, Frozen>(count / 64);
+
+	double serial{ measure(repeats, [&]() { pool.apply<Position, const Velocity>(integrate); }) };
+	std::printf("entities %zu\n", pool.size());
+	std::printf("%-10s %12s %10s\n", "threads", "ms", "speedup");
+	std::printf("%-10s %12.3f %10.2f\n", "apply", serial, 1.0);
+
+	for (size_t threads{ 1 }; threads <= maxThreads; ++threads)
+	{
+		ThreadPool executor{ threads };
+		double elapsed{ measure(repeats, [&]() { pool.parallelApply<Position, const Velocity>(integrate, Pool::DEFAULT_GRAIN, executor); }) };
+		std::printf("%-10zu %12.3f %10.2f\n", threads, elapsed, serial / elapsed);
+	}
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "../src/sparse_vector.h"
+#include "common.h"
+
+using Byte::sparse_vector;
+
+void report(const char* name, size_t operations, double milliseconds)
+{
+	std::printf("%-24s %12.3f ms %10.2f ns/op\n", name, milliseconds, milliseconds * 1e6 / static_cast<double>(operations));
+}
+
+uint64_t iterate(sparse_vector<uint64_t>& values)
+{
+	uint64_t sum{ 0 };
+	for (auto value : values)
+	{
+		sum += value;
+	}
+	return sum;
+}
+
+int main(int argc, char** argv)
+{
+	size_t count{ argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t{ 1 } << 21 };
+	uint64_t checksum{ 0 };
+
+	sparse_vector<uint64_t> values;
+	std::vector<size_t> slots;
+	slots.reserve(count);
+
+	std::printf("slots %zu\n", count);
+
+	report("push", count, measure(1, [&]()
+		{
+			for (size_t index{}; index < count; ++index)
+			{
+				slots.push_back(values.push(index));
+			}
+		}));
+
+	report("iterate full", count, measure(1, [&]() { checksum += iterate(values); }));
+
+	std::mt19937_64 random{ 42 };
+	std::shuffle(slots.begin(), slots.end(), random);
+	size_t erased{ count / 2 };
+
+	report("erase random half", erased, measure(1, [&]()
+		{
+			for (size_t index{}; index < erased; ++index)
+			{
+				values.erase(slots[index]);
+			}
+		}));
+
+	report("iterate half", count - erased, measure(1, [&]() { checksum += iterate(values); }));
+
+	report("push into holes", erased, measure(1, [&]()
+		{
+			for (size_t index{}; index < erased; ++index)
+			{
+				slots[index] = values.push(index);
+			}
+		}));
+
+	// Leave a single live slot per 4096 to measure how fast empty blocks are skipped.
+	std::sort(slots.begin(), slots.end());
+	size_t kept{ 0 };
+	for (auto slot : slots)
+	{
+		if (slot % 4096 == 0)
+		{
+			++kept;
+			continue;
+		}
+		values.erase(slot);
+	}
+
+	report("iterate sparse", kept, measure(1, [&]() { checksum += iterate(values); }));
+
+	report("refill sparse", count - kept, measure(1, [&]()
+		{
+			for (size_t index{}; index < count - kept; ++index)
+			{
+				values.push(index);
+			}
+		}));
+
+	std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+	return 0;
+}
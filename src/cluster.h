@@ -3,47 +3,402 @@
 
 #include <unordered_map>
 #include <memory>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <span>
+#include <memory_resource>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
 
 #include "signature.h"
-#include "accessor.h"
+#include "column.h"
 #include "component.h"
+#include "policy.h"
 
-#include "Byte/Container/shrink_vector.h"
+#include "Byte/Container/sparse_vector.h"
 
 namespace Byte::ECS
 {
 
+	class Cluster;
+
+	struct EntityLocation
+	{
+		Cluster* cluster{ nullptr };
+		size_t index;
+	};
+
+	using EntityLocationContainer = sparse_vector<EntityLocation, std::pmr::polymorphic_allocator<EntityLocation>>;
+
+	enum class ClusterStorage : uint8_t
+	{
+		CONTIGUOUS,
+		CHUNKED
+	};
+
+	enum class SortMode : uint8_t
+	{
+		FULL,
+		INCREMENTAL
+	};
+
+	using ColumnMap = std::vector<std::pair<Column*, Column*>>;
+
+	struct SharedValue
+	{
+		ComponentID id;
+		uint32_t index;
+		const void* value;
+
+		bool operator==(const SharedValue& left) const
+		{
+			return id == left.id && index == left.index;
+		}
+
+		bool operator!=(const SharedValue& left) const
+		{
+			return !(*this == left);
+		}
+	};
+
+	using SharedValues = std::vector<SharedValue>;
+
+	struct ComponentPayload
+	{
+		ComponentID id;
+		const ComponentInfo* info;
+		void* data;
+	};
+
+	struct ClusterKey
+	{
+		Signature signature;
+		SharedValues shared;
+
+		bool operator==(const ClusterKey& left) const
+		{
+			return signature == left.signature && shared == left.shared;
+		}
+
+		bool operator!=(const ClusterKey& left) const
+		{
+			return !(*this == left);
+		}
+	};
+
+	struct ClusterEdge
+	{
+		Cluster* destination{ nullptr };
+		ColumnMap columns;
+	};
+
+	class EntityColumn
+	{
+	private:
+		using ChunkContainer = std::pmr::vector<EntityID*>;
+
+	public:
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = EntityID;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const EntityID*;
+			using reference = const EntityID&;
+
+		private:
+			const EntityColumn* column{ nullptr };
+			size_t index{ 0 };
+
+		public:
+			Iterator() = default;
+
+			Iterator(const EntityColumn* column, size_t index)
+				:column{ column }, index{ index }
+			{
+			}
+
+			reference operator*() const
+			{
+				return (*column)[index];
+			}
+
+			Iterator& operator++()
+			{
+				++index;
+				return *this;
+			}
+
+			Iterator operator++(int)
+			{
+				Iterator out{ *this };
+				++index;
+				return out;
+			}
+
+			bool operator==(const Iterator& left) const
+			{
+				return index == left.index;
+			}
+
+			bool operator!=(const Iterator& left) const
+			{
+				return index != left.index;
+			}
+		};
+
+	private:
+		std::pmr::memory_resource* _resource;
+		ChunkContainer chunks;
+		size_t _size{ 0 };
+		size_t _capacity{ 0 };
+		size_t _chunkCapacity{ 0 };
+
+	public:
+		EntityColumn(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			:_resource{ resource }, chunks{ resource }
+		{
+		}
+
+		EntityColumn(const EntityColumn&) = delete;
+
+		EntityColumn(EntityColumn&& right) noexcept
+			:_resource{ right._resource }, chunks{ std::move(right.chunks) }, _size{ right._size },
+			_capacity{ right._capacity }, _chunkCapacity{ right._chunkCapacity }
+		{
+			right.chunks.clear();
+			right._size = 0;
+			right._capacity = 0;
+		}
+
+		~EntityColumn()
+		{
+			deallocate();
+		}
+
+		EntityColumn& operator=(const EntityColumn&) = delete;
+
+		EntityColumn& operator=(EntityColumn&& right) noexcept
+		{
+			if (this != &right)
+			{
+				deallocate();
+				_resource = right._resource;
+				chunks = std::move(right.chunks);
+				_size = right._size;
+				_capacity = right._capacity;
+				_chunkCapacity = right._chunkCapacity;
+
+				right.chunks.clear();
+				right._size = 0;
+				right._capacity = 0;
+			}
+			return *this;
+		}
+
+		EntityID& operator[](size_t index)
+		{
+			if (chunked())
+			{
+				return chunks[index / _chunkCapacity][index % _chunkCapacity];
+			}
+			return chunks.front()[index];
+		}
+
+		const EntityID& operator[](size_t index) const
+		{
+			return const_cast<EntityColumn&>(*this)[index];
+		}
+
+		Iterator begin() const
+		{
+			return Iterator{ this, 0 };
+		}
+
+		Iterator end() const
+		{
+			return Iterator{ this, _size };
+		}
+
+		EntityID* chunk(size_t index)
+		{
+			if (chunked())
+			{
+				return chunks[index];
+			}
+			return chunks.empty() ? nullptr : chunks.front();
+		}
+
+		const EntityID* chunk(size_t index) const
+		{
+			return const_cast<EntityColumn&>(*this).chunk(index);
+		}
+
+		size_t size() const
+		{
+			return _size;
+		}
+
+		size_t capacity() const
+		{
+			return _capacity;
+		}
+
+		bool empty() const
+		{
+			return _size == 0;
+		}
+
+		bool chunked() const
+		{
+			return _chunkCapacity != 0;
+		}
+
+		void chunkCapacity(size_t chunkCapacity)
+		{
+			_chunkCapacity = chunkCapacity;
+		}
+
+		void push_back(EntityID id)
+		{
+			(*this)[_size++] = id;
+		}
+
+		void pop_back()
+		{
+			--_size;
+		}
+
+		void clear()
+		{
+			_size = 0;
+		}
+
+		void reserve(size_t capacity)
+		{
+			if (!chunked() && capacity > _capacity)
+			{
+				reallocate(capacity);
+			}
+		}
+
+		void shrink(size_t capacity)
+		{
+			if (!chunked() && capacity < _capacity)
+			{
+				reallocate(std::max(capacity, _size));
+			}
+		}
+
+		void attach(std::byte* chunk)
+		{
+			chunks.push_back(reinterpret_cast<EntityID*>(chunk));
+			_capacity += _chunkCapacity;
+		}
+
+		void detach()
+		{
+			chunks.pop_back();
+			_capacity -= _chunkCapacity;
+		}
+
+	private:
+		void deallocate()
+		{
+			if (!chunked() && !chunks.empty())
+			{
+				_resource->deallocate(chunks.front(), _capacity * sizeof(EntityID), alignof(EntityID));
+			}
+
+			chunks.clear();
+			_capacity = 0;
+		}
+
+		void reallocate(size_t capacity)
+		{
+			EntityID* buffer{ capacity > 0 ? static_cast<EntityID*>(_resource->allocate(capacity * sizeof(EntityID), alignof(EntityID))) : nullptr };
+
+			if (!chunks.empty())
+			{
+				std::copy_n(chunks.front(), _size, buffer);
+				_resource->deallocate(chunks.front(), _capacity * sizeof(EntityID), alignof(EntityID));
+				chunks.clear();
+			}
+
+			if (buffer)
+			{
+				chunks.push_back(buffer);
+			}
+
+			_capacity = capacity;
+		}
+	};
+
 	class Cluster
 	{
 	private:
-		using EntityIDContainer = shrink_vector<EntityID>;
-		using AccessorMap = std::unordered_map<ComponentID,UniqueAccessor>;
+		using EntityIDContainer = EntityColumn;
+		using ColumnContainer = std::pmr::vector<Column>;
+		using ComponentIDContainer = std::pmr::vector<ComponentID>;
+		using IndexContainer = std::pmr::vector<uint16_t>;
+		using BlockContainer = std::pmr::vector<std::byte*>;
+		using OffsetContainer = std::pmr::vector<size_t>;
+		using EdgeContainer = std::vector<ClusterEdge>;
+		using ComponentLayout = std::vector<std::pair<ComponentID, const ComponentInfo*>>;
 
 		friend struct ClusterBuilder;
 		friend struct ClusterBridge;
 		template<typename... Types>
 		friend struct ClusterCache;
 
+	public:
+		inline static constexpr size_t CHUNK_SIZE{ 16 * 1024 };
+		inline static constexpr uint16_t NO_COLUMN{ UINT16_MAX };
+
 	private:
+		std::pmr::memory_resource* _resource{ std::pmr::get_default_resource() };
 		Signature _signature;
 		EntityIDContainer _entities;
-		AccessorMap accessors;
+		ColumnContainer columns;
+		ComponentIDContainer componentIDs;
+		IndexContainer indices;
+		BlockContainer blocks;
+		OffsetContainer offsets;
+		EdgeContainer addEdges;
+		EdgeContainer removeEdges;
+		SharedValues _shared;
+		ClusterStorage _storage{ ClusterStorage::CONTIGUOUS };
+		size_t _chunkCapacity{ 0 };
+		size_t _blockSize{ 0 };
+		size_t _blockAlignment{ Column::ALIGNMENT };
+		GrowthPolicy _policy;
 
 	public:
 		Cluster() = default;
 
-		Cluster(const Signature& _signature)
-			:_signature{ _signature }
+		Cluster(const Signature& _signature, ClusterStorage _storage = ClusterStorage::CONTIGUOUS,
+			std::pmr::memory_resource* _resource = std::pmr::get_default_resource())
+			:_resource{ _resource }, _signature{ _signature }, _entities{ _resource }, columns{ _resource },
+			componentIDs{ _resource }, indices{ _resource }, blocks{ _resource }, offsets{ _resource }, _storage{ _storage }
 		{
 		}
 
 		Cluster(const Cluster& left)
-			:Cluster{ copy() }
+			:Cluster{ left.copy() }
 		{
 		}
 
 		Cluster(Cluster&& right) noexcept = default;
 
+		~Cluster()
+		{
+			deallocate();
+		}
+
 		Cluster& operator=(const Cluster& left)
 		{
 			*this = left.copy();
@@ -52,12 +407,12 @@ namespace Byte::ECS
 
 		Cluster& operator=(Cluster&& right) noexcept
 		{
-			_signature = right._signature;
-			_entities = std::move(right._entities);
-			accessors = std::move(right.accessors);
-
-			right._signature.clear();
-
+			if (this != &right)
+			{
+				std::destroy_at(this);
+				std::construct_at(this, std::move(right));
+				right._signature.clear();
+			}
 			return *this;
 		}
 
@@ -71,21 +426,167 @@ namespace Byte::ECS
 			return _entities;
 		}
 
+		std::span<const EntityID> entityChunk(size_t chunk) const
+		{
+			return std::span<const EntityID>{ _entities.chunk(chunk), chunkSize(chunk) };
+		}
+
+		const SharedValues& shared() const
+		{
+			return _shared;
+		}
+
+		const void* shared(ComponentID id) const
+		{
+			for (auto& value : _shared)
+			{
+				if (value.id == id)
+				{
+					return value.value;
+				}
+			}
+			return nullptr;
+		}
+
+		ClusterKey key() const
+		{
+			return ClusterKey{ _signature, _shared };
+		}
+
+		std::pmr::memory_resource* resource() const
+		{
+			return _resource;
+		}
+
+		ClusterStorage storage() const
+		{
+			return _storage;
+		}
+
+		bool chunked() const
+		{
+			return _storage == ClusterStorage::CHUNKED;
+		}
+
+		size_t chunkCapacity() const
+		{
+			if (chunked())
+			{
+				return _chunkCapacity;
+			}
+			return std::max<size_t>(size(), 1);
+		}
+
+		size_t chunkCount() const
+		{
+			return (size() + chunkCapacity() - 1) / chunkCapacity();
+		}
+
+		size_t chunkSize(size_t chunk) const
+		{
+			return std::min(chunkCapacity(), size() - chunk * chunkCapacity());
+		}
+
 		void pushEntity(EntityID id)
 		{
+			if (_entities.size() == _entities.capacity())
+			{
+				reserve(chunked() ? _entities.size() + 1 : _policy.grow(_entities.capacity(), _entities.size() + 1));
+			}
 			_entities.push_back(id);
 		}
 
+		void reserve(size_t capacity)
+		{
+			if (chunked())
+			{
+				while (_entities.capacity() < capacity)
+				{
+					allocateBlock();
+				}
+				return;
+			}
+
+			_entities.reserve(capacity);
+			for (auto& column : columns)
+			{
+				column.reserve(capacity);
+			}
+		}
+
+		void clear()
+		{
+			_entities.clear();
+			for (auto& column : columns)
+			{
+				column.clear();
+			}
+		}
+
+		void compact()
+		{
+			if (_policy.shrinks(_entities.size(), _entities.capacity()))
+			{
+				size_t capacity{ _policy.shrink(_entities.size()) };
+				if (chunked())
+				{
+					while (!blocks.empty() && _entities.capacity() - _chunkCapacity >= capacity)
+					{
+						releaseBlock();
+					}
+				}
+				else
+				{
+					_entities.shrink(capacity);
+				}
+			}
+
+			for (auto& column : columns)
+			{
+				column.compact();
+			}
+		}
+
+		const GrowthPolicy& policy() const
+		{
+			return _policy;
+		}
+
+		void policy(const GrowthPolicy& policy)
+		{
+			_policy = policy;
+			for (auto& column : columns)
+			{
+				column.policy(policy);
+			}
+		}
+
+		void policy(ComponentID id, const GrowthPolicy& policy)
+		{
+			Column* column{ find(id) };
+			if (column)
+			{
+				column->policy(policy);
+			}
+		}
+
+		void resizeColumns(size_t size)
+		{
+			for (auto& column : columns)
+			{
+				column.resize(size);
+			}
+		}
+
 		EntityID remove(size_t index)
 		{
 			EntityID out{ _entities[size() - 1] };
 			
 			_entities[index] = out;
 			
-			for (auto& pair : accessors)
+			for (auto& column : columns)
 			{
-				pair.second->swap(index, size() - 1);
-				pair.second->pop();
+				column.remove(index);
 			}
 
 			_entities.pop_back();
@@ -93,28 +594,61 @@ namespace Byte::ECS
 			return out;
 		}
 
+		void permute(const std::vector<size_t>& order)
+		{
+			for (auto& column : columns)
+			{
+				column.permute(order);
+			}
+
+			std::vector<EntityID> entities;
+			entities.reserve(order.size());
+			for (auto index : order)
+			{
+				entities.push_back(_entities[index]);
+			}
+			for (size_t index{}; index < entities.size(); ++index)
+			{
+				_entities[index] = entities[index];
+			}
+		}
+
 		template<typename Type>
 		void push(Type&& item)
 		{
-			accessor<Type>().push(std::move(item));
+			if constexpr (!ComponentRegistry<Type>::tag)
+			{
+				column<Type>().template emplace<Type>(std::move(item));
+			}
 		}
 
 		template<typename Type, typename... Args>
 		void emplace(Args&&... items)
 		{
-			accessor<Type>().emplace(std::move(items));
+			if constexpr (!ComponentRegistry<Type>::tag)
+			{
+				column<Type>().template emplace<Type>(std::forward<Args>(items)...);
+			}
 		}
 
 		template<typename Type>
 		Type& get(size_t index)
 		{
-			return accessor<Type>().at(index);
+			return column<Type>().template get<Type>(index);
+		}
+
+		template<typename Type>
+		Type& get(size_t index, Tick tick)
+		{
+			Column& out{ column<Type>() };
+			out.markChanged(index, tick);
+			return out.template get<Type>(index);
 		}
 
 		template<typename Type>
 		const Type& get(size_t index) const
 		{
-			return accessor<Type>().at(index);
+			return const_cast<Cluster&>(*this).get<Type>(index);
 		}
 
 		size_t size() const
@@ -127,55 +661,256 @@ namespace Byte::ECS
 			return size() == 0;
 		}
 
+		const Column* lookup(ComponentID id) const
+		{
+			return const_cast<Cluster&>(*this).find(id);
+		}
+
+		void markChanged(ComponentID id, size_t index, Tick tick)
+		{
+			column(id).markChanged(index, tick);
+		}
+
+		void markAdded(ComponentID id, size_t index, Tick tick)
+		{
+			column(id).markAdded(index, index + 1, tick);
+		}
+
+		void push(ComponentID id, void* component, Tick tick)
+		{
+			if (Column* column{ find(id) })
+			{
+				column->moveIn(component);
+				column->markAdded(column->size() - 1, column->size(), tick);
+			}
+		}
+
+		void replace(ComponentID id, size_t index, void* component, Tick tick)
+		{
+			if (Column* column{ find(id) })
+			{
+				column->replace(index, component);
+				column->markChanged(index, tick);
+			}
+		}
+
+		void markAdded(size_t begin, size_t end, Tick tick)
+		{
+			for (auto& column : columns)
+			{
+				column.markAdded(begin, end, tick);
+			}
+		}
+
+		ClusterEdge& addEdge(ComponentID id)
+		{
+			return edge(addEdges, id);
+		}
+
+		ClusterEdge& removeEdge(ComponentID id)
+		{
+			return edge(removeEdges, id);
+		}
+
 		Cluster copy() const
 		{
-			Cluster out{ _signature };
-			out._entities = _entities;
-			for (auto& pair : accessors)
+			Cluster out{ _signature, _storage, _resource };
+			out._shared = _shared;
+			out.layout(components());
+			out.policy(_policy);
+			for (size_t column{}; column < columns.size(); ++column)
 			{
-				out.accessors[pair.first] = pair.second->copy();
+				out.columns[column].policy(columns[column].policy());
+			}
+
+			out.reserve(size());
+			for (size_t index{}; index < size(); ++index)
+			{
+				out.pushEntity(_entities[index]);
+				for (size_t column{}; column < columns.size(); ++column)
+				{
+					out.columns[column].copyIn(columns[column], index);
+				}
 			}
 			return out;
 		}
 
 	private:
-		template<typename Type>
-		Accessor<Type>& accessor()
+		void allocateBlock()
 		{
-			ComponentID id{ ComponentRegistry<Type>::id };
-			return static_cast<Accessor<Type>&>(*accessors.at(id));
+			std::byte* block{ static_cast<std::byte*>(_resource->allocate(_blockSize, _blockAlignment)) };
+			blocks.push_back(block);
+
+			_entities.attach(block);
+			for (size_t column{}; column < columns.size(); ++column)
+			{
+				columns[column].attach(block + offsets[column]);
+			}
 		}
-		
+
+		void releaseBlock()
+		{
+			_entities.detach();
+			for (auto& column : columns)
+			{
+				column.detach();
+			}
+
+			_resource->deallocate(blocks.back(), _blockSize, _blockAlignment);
+			blocks.pop_back();
+		}
+
+		void deallocate()
+		{
+			columns.clear();
+			for (auto block : blocks)
+			{
+				_resource->deallocate(block, _blockSize, _blockAlignment);
+			}
+			blocks.clear();
+		}
+
+		size_t blockSize(size_t capacity, const ComponentLayout& components)
+		{
+			size_t out{ capacity * sizeof(EntityID) };
+			offsets.clear();
+
+			for (auto& component : components)
+			{
+				size_t alignment{ std::max(Column::ALIGNMENT, component.second->alignment) };
+				_blockAlignment = std::max(_blockAlignment, alignment);
+				out = (out + alignment - 1) / alignment * alignment;
+				offsets.push_back(out);
+				out += capacity * component.second->size;
+			}
+			return out;
+		}
+
+		static ClusterEdge& edge(EdgeContainer& edges, ComponentID id)
+		{
+			if (id >= edges.size())
+			{
+				edges.resize(static_cast<size_t>(id) + 1);
+			}
+			return edges[id];
+		}
+
+		size_t index(ComponentID id) const
+		{
+			return indices[id];
+		}
+
+		Column& column(ComponentID id)
+		{
+			return columns[index(id)];
+		}
+
+		Column* find(ComponentID id)
+		{
+			if (id < indices.size() && indices[id] != NO_COLUMN)
+			{
+				return &column(id);
+			}
+			return nullptr;
+		}
+
 		template<typename Type>
-		const Accessor<Type>& accessor() const
+		Column& column()
+		{
+			static_assert(!ComponentRegistry<Type>::tag, "Tag components have no storage");
+			static_assert(!ComponentRegistry<Type>::sparse, "Sparse components are not stored in clusters");
+			static_assert(!ComponentRegistry<Type>::shared, "Shared components are stored once per cluster");
+			return column(ComponentRegistry<Type>::id);
+		}
+
+		ComponentLayout components() const
 		{
-			ComponentID id{ ComponentRegistry<Type>::id };
-			return static_cast<Accessor<Type>&>(*accessors.at(id));
+			ComponentLayout out;
+			for (size_t index{}; index < columns.size(); ++index)
+			{
+				out.emplace_back(componentIDs[index], &columns[index].info());
+			}
+			return out;
+		}
+
+		void layout(ComponentLayout components)
+		{
+			std::erase_if(components, [](const auto& component)
+				{
+					return component.second->tag;
+				});
+
+			std::sort(components.begin(), components.end(), [](const auto& left, const auto& right)
+				{
+					return left.first < right.first;
+				});
+
+			size_t rowSize{ sizeof(EntityID) };
+			for (auto& component : components)
+			{
+				rowSize += component.second->size;
+			}
+
+			if (chunked())
+			{
+				_chunkCapacity = std::max<size_t>(CHUNK_SIZE / rowSize, 1);
+				while (_chunkCapacity > 1 && blockSize(_chunkCapacity, components) > CHUNK_SIZE)
+				{
+					--_chunkCapacity;
+				}
+
+				_blockSize = std::max(blockSize(_chunkCapacity, components), CHUNK_SIZE);
+				_entities.chunkCapacity(_chunkCapacity);
+			}
+
+			columns.clear();
+			componentIDs.clear();
+			columns.reserve(components.size());
+
+			for (auto& component : components)
+			{
+				columns.emplace_back(*component.second, _chunkCapacity, _resource);
+				componentIDs.push_back(component.first);
+			}
+
+			indices.assign(componentIDs.empty() ? 0 : componentIDs.back() + 1, NO_COLUMN);
+			for (size_t index{}; index < componentIDs.size(); ++index)
+			{
+				indices[componentIDs[index]] = static_cast<uint16_t>(index);
+			}
 		}
 	};
 
 	struct ClusterBuilder
 	{
 		template<typename... Types>
-		static Cluster build()
+		static Cluster build(ClusterStorage storage = ClusterStorage::CONTIGUOUS,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource())
 		{
-			Cluster out{ SignatureBuilder<Types...>()};
-			(push<Types>(out), ...);
+			Cluster out{ SignatureBuilder<Types...>(), storage, resource };
+			Cluster::ComponentLayout components;
+
+			((ComponentRegistry<Types>::shared ?
+				void() :
+				void(components.emplace_back(ComponentRegistry<Types>::id, &ComponentRegistry<Types>::info))), ...);
+
+			out.layout(std::move(components));
 			return out;
 		}
 
 		template<typename... Types>
 		static Cluster build(const Cluster& initial)
 		{
-			Signature signature{ initial._signature };
-			Cluster out{ signature };
+			Cluster out{ initial._signature, initial._storage, initial._resource };
+			out._shared = initial._shared;
+			Cluster::ComponentLayout components{ initial.components() };
 
-			for (auto& pair : initial.accessors)
-			{
-				out.accessors[pair.first] = pair.second->instance();
-			}
+			((initial._signature.test(ComponentRegistry<Types>::id) || ComponentRegistry<Types>::shared ?
+				void() :
+				void(components.emplace_back(ComponentRegistry<Types>::id, &ComponentRegistry<Types>::info))), ...);
 
-			((push<Types>(out), out._signature.set(ComponentRegistry<Types>::id)), ...);
+			(out._signature.set(ComponentRegistry<Types>::id), ...);
+			out.layout(std::move(components));
 			return out;
 		}
 
@@ -184,38 +919,95 @@ namespace Byte::ECS
 		{
 			Signature signature{ initial._signature };
 			signature.set(ComponentRegistry<Type>::id, false);
-			Cluster out{ signature };
+			Cluster out{ signature, initial._storage, initial._resource };
+			out._shared = initial._shared;
+			std::erase_if(out._shared, [](const SharedValue& value)
+				{
+					return value.id == ComponentRegistry<Type>::id;
+				});
+
+			Cluster::ComponentLayout components{ initial.components() };
+			std::erase_if(components, [](const auto& component)
+				{
+					return component.first == ComponentRegistry<Type>::id;
+				});
 
-			for (auto& pair : initial.accessors)
+			out.layout(std::move(components));
+			return out;
+		}
+
+		static Cluster build(const Signature& signature, std::span<const ComponentPayload> added, const Cluster* initial,
+			ClusterStorage storage = ClusterStorage::CONTIGUOUS, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		{
+			Cluster out{ signature, initial ? initial->_storage : storage, initial ? initial->_resource : resource };
+			Cluster::ComponentLayout components;
+
+			if (initial)
 			{
-				if (pair.first != ComponentRegistry<Type>::id)
+				out._shared = initial->_shared;
+				for (auto& component : initial->components())
 				{
-					out.accessors[pair.first] = pair.second->instance();
+					if (signature.test(component.first))
+					{
+						components.push_back(component);
+					}
 				}
 			}
 
+			for (auto& payload : added)
+			{
+				if (signature.test(payload.id) && (!initial || !initial->_signature.test(payload.id)))
+				{
+					components.emplace_back(payload.id, payload.info);
+				}
+			}
+
+			out.layout(std::move(components));
 			return out;
 		}
 
-	private:
-		template<typename Type>
-		static void push(Cluster& cluster)
+		static Cluster share(Cluster&& cluster, const SharedValues& shared)
 		{
-			cluster.accessors[ComponentRegistry<Type>::id] = std::make_unique<Accessor<Type>>();
+			cluster._shared = shared;
+			return std::move(cluster);
 		}
 	};
 
 	struct ClusterBridge
 	{
+		static ColumnMap map(Cluster& source, Cluster& destination)
+		{
+			ColumnMap out;
+			for (size_t index{}; index < source.columns.size(); ++index)
+			{
+				Column* column{ destination.find(source.componentIDs[index]) };
+				if (column)
+				{
+					out.emplace_back(&source.columns[index], column);
+				}
+			}
+			return out;
+		}
+
+		static size_t carry(Cluster& destination, const ColumnMap& columns, EntityID id, size_t index)
+		{
+			destination.pushEntity(id);
+			for (auto& pair : columns)
+			{
+				pair.second->moveIn(*pair.first, index);
+			}
+			return destination.size() - 1;
+		}
+
 		static size_t carry(Cluster& source, Cluster& destination, EntityID id, size_t index)
 		{
 			destination.pushEntity(id);
-			for (auto& pair : source.accessors)
+			for (size_t column{}; column < source.columns.size(); ++column)
 			{
-				auto accessor{destination.accessors.find(pair.first)};
-				if (accessor!= destination.accessors.end())
+				Column* target{ destination.find(source.componentIDs[column]) };
+				if (target)
 				{
-					accessor->second->carryIn(pair.second, index);
+					target->moveIn(source.columns[column], index);
 				}
 			}
 			return destination.size() - 1;
@@ -224,12 +1016,12 @@ namespace Byte::ECS
 		static size_t copy(const Cluster& source, Cluster& destination, EntityID id, size_t index)
 		{
 			destination.pushEntity(id);
-			for (auto& pair : source.accessors)
+			for (size_t column{}; column < source.columns.size(); ++column)
 			{
-				auto accessor{ destination.accessors.find(pair.first) };
-				if (accessor != destination.accessors.end())
+				Column* target{ destination.find(source.componentIDs[column]) };
+				if (target)
 				{
-					accessor->second->copyIn(pair.second, index);
+					target->copyIn(source.columns[column], index);
 				}
 			}
 			return destination.size() - 1;
@@ -244,58 +1036,165 @@ namespace Byte::ECS
 	template<typename... Types>
 	struct ClusterCache
 	{
+		static_assert((!ComponentRegistry<Types>::sparse && ...), "Sparse components are not stored in clusters, iterate them with Pool::join");
+		static_assert(((!ComponentRegistry<Types>::shared || std::is_const_v<Types>) && ...), "Shared components are read-only, view them as const");
+
 	private:
-		using EntityIDContainer = typename Cluster::EntityIDContainer;
-		using AccessorMap = typename Cluster::AccessorMap;
-		using AccessorCache = std::vector<IAccessor*>;
-		using IDComponentGroup = IDComponentGroup<Types&...>;
-		using ComponentGroup = ComponentGroup<Types&...>;
+		using ColumnCache = std::array<Column*, sizeof...(Types)>;
+		using SharedCache = std::array<const void*, sizeof...(Types)>;
+		using Group = ComponentGroup<Types...>;
+		using IDGroup = IDComponentGroup<Types...>;
+		using Chunk = std::tuple<Types*...>;
+		using Sequence = std::index_sequence_for<Types...>;
 
 	private:
-		AccessorCache accessors;
-		EntityIDContainer* entities{ nullptr };
+		ColumnCache columns{};
+		SharedCache shared{};
+		Cluster* cluster{ nullptr };
 
 	public:
 		ClusterCache(Cluster& cluster)
-			:entities{ &cluster._entities }
+			:columns{ (ComponentRegistry<Types>::tag || ComponentRegistry<Types>::shared ? nullptr : &cluster.column(ComponentRegistry<Types>::id))... },
+			shared{ (ComponentRegistry<Types>::shared ? cluster.shared(ComponentRegistry<Types>::id) : nullptr)... }, cluster{ &cluster }
 		{
-			((accessors.push_back(cluster.accessors.at(ComponentRegistry<Types>::id).get())),...);
 		}
 
 		ClusterCache() = default;
 
-		IDComponentGroup groupWithID(size_t index)
+		IDGroup groupWithID(size_t index)
+		{
+			return groupWithID(index, Sequence{});
+		}
+
+		Group group(size_t index)
+		{
+			return group(index, Sequence{});
+		}
+
+		Chunk chunk(size_t index)
+		{
+			return chunk(index, Sequence{});
+		}
+
+		template<typename Function>
+		void eachMutable(const Function& function)
+		{
+			eachMutable(function, Sequence{});
+		}
+
+		size_t chunkBase(size_t index) const
+		{
+			return index * cluster->chunkCapacity();
+		}
+
+		EntityID* entityChunk(size_t index)
+		{
+			return cluster->_entities.chunk(index);
+		}
+
+		size_t chunkCount() const
 		{
-			size_t iterator{ accessors.size() };
-			return IDComponentGroup(entities->at(index), get<Types>(index, --iterator)...);
+			if (!cluster)
+			{
+				return 0;
+			}
+			return cluster->chunkCount();
 		}
 
-		ComponentGroup group(size_t index)
+		size_t chunkSize(size_t index) const
 		{
-			size_t iterator{ accessors.size() };
-			return ComponentGroup(get<Types>(index, --iterator)...);
+			return cluster->chunkSize(index);
 		}
 
 		size_t size() const
 		{
-			if (accessors.empty())
+			if (!cluster)
 			{
 				return 0;
 			}
-			return accessors[0]->size();
+			return cluster->size();
 		}
 
 	private:
-		template<typename Type>
-		Type& get(size_t index, size_t accessorIndex)
+		template<size_t... Indices>
+		IDGroup groupWithID(size_t index, std::index_sequence<Indices...>)
+		{
+			return IDGroup(cluster->_entities[index], get<Types, Indices>(index)...);
+		}
+
+		template<size_t... Indices>
+		Group group(size_t index, std::index_sequence<Indices...>)
+		{
+			return Group(get<Types, Indices>(index)...);
+		}
+
+		template<typename Function, size_t... Indices>
+		void eachMutable(const Function& function, std::index_sequence<Indices...>)
+		{
+			((std::is_const_v<Types> || ComponentRegistry<Types>::tag || ComponentRegistry<Types>::shared ? void() : void(function(*columns[Indices]))), ...);
+		}
+
+		template<size_t... Indices>
+		Chunk chunk(size_t index, std::index_sequence<Indices...>)
 		{
-			return static_cast<Accessor<Type>*>(accessors[accessorIndex])->at(index);
+			return Chunk(pointer<Types, Indices>(index)...);
 		}
 
+		template<typename Type, size_t ColumnIndex>
+		Type* pointer(size_t index)
+		{
+			if constexpr (ComponentRegistry<Type>::tag)
+			{
+				static std::remove_const_t<Type> tag{};
+				return &tag;
+			}
+			else if constexpr (ComponentRegistry<Type>::shared)
+			{
+				return static_cast<Type*>(shared[ColumnIndex]);
+			}
+			else
+			{
+				return static_cast<Type*>(columns[ColumnIndex]->chunk(index));
+			}
+		}
+
+		template<typename Type, size_t ColumnIndex>
+		Type& get(size_t index)
+		{
+			if constexpr (ComponentRegistry<Type>::tag || ComponentRegistry<Type>::shared)
+			{
+				return *pointer<Type, ColumnIndex>(index);
+			}
+			else
+			{
+				return columns[ColumnIndex]->template get<Type>(index);
+			}
+		}
 	};
 
-	using ClusterContainer = std::unordered_map<Signature, Cluster>;
-	using ClusterGroup = std::vector<Cluster*>;
+	using ClusterContainer = std::pmr::unordered_map<ClusterKey, Cluster>;
+	using ClusterGroup = std::pmr::vector<Cluster*>;
+
+}
+
+namespace std
+{
+
+	template<>
+	struct hash<Byte::ECS::ClusterKey>
+	{
+		size_t operator()(const Byte::ECS::ClusterKey& key) const
+		{
+			uint64_t result{ hash<Byte::ECS::Signature>{}(key.signature) };
+
+			for (auto& value : key.shared)
+			{
+				result = (result ^ ((static_cast<uint64_t>(value.id) << 32) | value.index)) * 0x9E3779B97F4A7C15ULL;
+			}
+
+			return static_cast<size_t>(result);
+		}
+	};
 
 }
 
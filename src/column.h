@@ -0,0 +1,690 @@
+#ifndef BYTE_ECS_COLUMN_H
+#define BYTE_ECS_COLUMN_H
+
+#include <vector>
+#include <memory_resource>
+#include <new>
+#include <cstring>
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+
+#include "component.h"
+#include "policy.h"
+#include "typedefs.h"
+
+namespace Byte::ECS
+{
+
+	class Column
+	{
+	private:
+		using ChunkContainer = std::pmr::vector<std::byte*>;
+		using TickContainer = std::pmr::vector<Tick>;
+
+	public:
+		inline static constexpr size_t ALIGNMENT{ 64 };
+		inline static constexpr size_t TICK_BLOCK{ 256 };
+
+	private:
+		const ComponentInfo* _info;
+		std::pmr::memory_resource* _resource;
+		ChunkContainer chunks;
+		size_t _size{ 0 };
+		size_t _capacity{ 0 };
+		size_t _chunkCapacity{ 0 };
+		bool borrowed{ false };
+		GrowthPolicy _policy;
+		TickContainer changedTicks;
+		TickContainer addedTicks;
+		TickContainer changedBlocks;
+		TickContainer addedBlocks;
+		TickContainer writtenBlocks;
+		Tick _changed{ 0 };
+		Tick _added{ 0 };
+
+	public:
+		Column(const ComponentInfo& info, size_t chunkCapacity = 0,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			:_info{ &info }, _resource{ resource }, chunks{ resource }, _chunkCapacity{ chunkCapacity },
+			changedTicks{ resource }, addedTicks{ resource }, changedBlocks{ resource }, addedBlocks{ resource },
+			writtenBlocks{ resource }
+		{
+		}
+
+		Column(const Column& left)
+			:_info{ left._info }, _resource{ left._resource }, chunks{ left._resource },
+			_chunkCapacity{ left._chunkCapacity }, _policy{ left._policy },
+			changedTicks{ left._resource }, addedTicks{ left._resource },
+			changedBlocks{ left._resource }, addedBlocks{ left._resource }, writtenBlocks{ left._resource }
+		{
+			try
+			{
+				reserve(left._size);
+				for (size_t index{}; index < left._size; ++index)
+				{
+					copyIn(left, index);
+				}
+			}
+			catch (...)
+			{
+				clear();
+				deallocate();
+				throw;
+			}
+		}
+
+		Column(Column&& right) noexcept
+			:_info{ right._info }, _resource{ right._resource }, chunks{ std::move(right.chunks) }, _size{ right._size },
+			_capacity{ right._capacity }, _chunkCapacity{ right._chunkCapacity }, borrowed{ right.borrowed }, _policy{ right._policy },
+			changedTicks{ std::move(right.changedTicks) }, addedTicks{ std::move(right.addedTicks) },
+			changedBlocks{ std::move(right.changedBlocks) }, addedBlocks{ std::move(right.addedBlocks) },
+			writtenBlocks{ std::move(right.writtenBlocks) }, _changed{ right._changed }, _added{ right._added }
+		{
+			right.chunks.clear();
+			right._size = 0;
+			right._capacity = 0;
+		}
+
+		~Column()
+		{
+			clear();
+			deallocate();
+		}
+
+		Column& operator=(const Column& left)
+		{
+			if (this != &left)
+			{
+				*this = Column{ left };
+			}
+			return *this;
+		}
+
+		Column& operator=(Column&& right) noexcept
+		{
+			if (this != &right)
+			{
+				clear();
+				deallocate();
+				_info = right._info;
+				_resource = right._resource;
+				chunks = std::move(right.chunks);
+				_size = right._size;
+				_capacity = right._capacity;
+				_chunkCapacity = right._chunkCapacity;
+				borrowed = right.borrowed;
+				_policy = right._policy;
+				changedTicks = std::move(right.changedTicks);
+				addedTicks = std::move(right.addedTicks);
+				changedBlocks = std::move(right.changedBlocks);
+				addedBlocks = std::move(right.addedBlocks);
+				writtenBlocks = std::move(right.writtenBlocks);
+				_changed = right._changed;
+				_added = right._added;
+
+				right.chunks.clear();
+				right._size = 0;
+				right._capacity = 0;
+			}
+			return *this;
+		}
+
+		const ComponentInfo& info() const
+		{
+			return *_info;
+		}
+
+		std::pmr::memory_resource* resource() const
+		{
+			return _resource;
+		}
+
+		const GrowthPolicy& policy() const
+		{
+			return _policy;
+		}
+
+		void policy(const GrowthPolicy& policy)
+		{
+			_policy = policy;
+		}
+
+		void* at(size_t index)
+		{
+			return address(index);
+		}
+
+		const void* at(size_t index) const
+		{
+			return address(index);
+		}
+
+		template<typename Type>
+		Type& get(size_t index)
+		{
+			return *static_cast<Type*>(at(index));
+		}
+
+		template<typename Type, typename... Args>
+		Type& emplace(Args&&... items)
+		{
+			Type* out{ ::new (slot()) Type(std::forward<Args>(items)...) };
+			++_size;
+			pushTicks(0, 0);
+			return *out;
+		}
+
+		void moveIn(Column& source, size_t index)
+		{
+			void* destination{ slot() };
+
+			if (_info->trivial)
+			{
+				std::memcpy(destination, source.address(index), _info->size);
+			}
+			else
+			{
+				_info->move(destination, source.address(index));
+			}
+
+			++_size;
+			pushTicks(source.changed(index), source.addedTicks[index]);
+		}
+
+		void moveIn(void* source)
+		{
+			relocate(slot(), source, false);
+			++_size;
+			pushTicks(0, 0);
+		}
+
+		void replace(size_t index, void* source)
+		{
+			_info->destroy(address(index));
+			relocate(address(index), source, false);
+		}
+
+		void copyIn(const Column& source, size_t index)
+		{
+			if (!_info->copy)
+			{
+				throw std::logic_error{ "Component is not copy constructible" };
+			}
+
+			void* destination{ slot() };
+			_info->copy(destination, source.address(index));
+			++_size;
+			pushTicks(source.changed(index), source.addedTicks[index]);
+		}
+
+		void remove(size_t index)
+		{
+			size_t last{ _size - 1 };
+
+			if (_info->trivial)
+			{
+				if (index != last)
+				{
+					std::memcpy(address(index), address(last), _info->size);
+				}
+			}
+			else
+			{
+				_info->destroy(address(index));
+				if (index != last)
+				{
+					_info->move(address(index), address(last));
+					_info->destroy(address(last));
+				}
+			}
+
+			if (index != last)
+			{
+				Tick changed{ this->changed(last) };
+				settle(index / TICK_BLOCK, changed);
+				changedTicks[index] = changed;
+				addedTicks[index] = addedTicks[last];
+				raise(index, changed, addedTicks[index]);
+			}
+
+			--_size;
+			popTicks();
+		}
+
+		void permute(const std::vector<size_t>& order)
+		{
+			std::byte* temporary{ allocate(1) };
+			std::vector<bool> placed(_size);
+
+			for (size_t start{}; start < _size; ++start)
+			{
+				if (placed[start] || order[start] == start)
+				{
+					continue;
+				}
+
+				relocate(temporary, address(start));
+
+				size_t current{ start };
+				for (size_t next{ order[current] }; next != start; current = next, next = order[current])
+				{
+					relocate(address(current), address(next));
+					placed[current] = true;
+				}
+
+				relocate(address(current), temporary);
+				placed[current] = true;
+			}
+
+			release(temporary, 1);
+			permuteTicks(order);
+		}
+
+		size_t size() const
+		{
+			return _size;
+		}
+
+		size_t capacity() const
+		{
+			return _capacity;
+		}
+
+		Tick changed() const
+		{
+			return _changed;
+		}
+
+		Tick added() const
+		{
+			return _added;
+		}
+
+		Tick changed(size_t index) const
+		{
+			return std::max(changedTicks[index], writtenBlocks[index / TICK_BLOCK]);
+		}
+
+		Tick added(size_t index) const
+		{
+			return addedTicks[index];
+		}
+
+		Tick changedBlock(size_t block) const
+		{
+			return changedBlocks[block];
+		}
+
+		Tick addedBlock(size_t block) const
+		{
+			return addedBlocks[block];
+		}
+
+		void markChanged(size_t index, Tick tick)
+		{
+			changedTicks[index] = tick;
+			changedBlocks[index / TICK_BLOCK] = std::max(changedBlocks[index / TICK_BLOCK], tick);
+			_changed = std::max(_changed, tick);
+		}
+
+		void markChanged(size_t begin, size_t end, Tick tick)
+		{
+			if (begin == end)
+			{
+				return;
+			}
+
+			size_t first{ (begin + TICK_BLOCK - 1) / TICK_BLOCK };
+			size_t last{ end == _size ? (end + TICK_BLOCK - 1) / TICK_BLOCK : end / TICK_BLOCK };
+
+			if (first >= last)
+			{
+				std::fill(changedTicks.begin() + begin, changedTicks.begin() + end, tick);
+			}
+			else
+			{
+				std::fill(changedTicks.begin() + begin, changedTicks.begin() + first * TICK_BLOCK, tick);
+				std::fill(writtenBlocks.begin() + first, writtenBlocks.begin() + last, tick);
+				if (last * TICK_BLOCK < end)
+				{
+					std::fill(changedTicks.begin() + last * TICK_BLOCK, changedTicks.begin() + end, tick);
+				}
+			}
+
+			for (size_t block{ begin / TICK_BLOCK }; block <= (end - 1) / TICK_BLOCK; ++block)
+			{
+				changedBlocks[block] = std::max(changedBlocks[block], tick);
+			}
+			_changed = std::max(_changed, tick);
+		}
+
+		void markAdded(size_t begin, size_t end, Tick tick)
+		{
+			if (begin == end)
+			{
+				return;
+			}
+
+			std::fill(addedTicks.begin() + begin, addedTicks.begin() + end, tick);
+			for (size_t block{ begin / TICK_BLOCK }; block <= (end - 1) / TICK_BLOCK; ++block)
+			{
+				addedBlocks[block] = std::max(addedBlocks[block], tick);
+			}
+			_added = std::max(_added, tick);
+
+			markChanged(begin, end, tick);
+		}
+
+		void reserve(size_t capacity)
+		{
+			if (chunked())
+			{
+				while (!borrowed && _capacity < capacity)
+				{
+					chunks.push_back(allocate(_chunkCapacity));
+					_capacity += _chunkCapacity;
+				}
+			}
+			else if (capacity > _capacity)
+			{
+				reallocate(capacity);
+			}
+
+			reserveTicks(_capacity);
+		}
+
+		void attach(std::byte* chunk)
+		{
+			borrowed = true;
+			chunks.push_back(chunk);
+			_capacity += _chunkCapacity;
+			reserveTicks(_capacity);
+		}
+
+		void detach()
+		{
+			chunks.pop_back();
+			_capacity -= _chunkCapacity;
+		}
+
+		void resize(size_t size)
+		{
+			if (size > _size && !_info->construct)
+			{
+				throw std::logic_error{ "Component is not default constructible" };
+			}
+
+			reserve(size);
+
+			for (; _size < size; ++_size)
+			{
+				_info->construct(address(_size));
+				pushTicks(0, 0);
+			}
+
+			while (_size > size)
+			{
+				_info->destroy(address(--_size));
+				popTicks();
+			}
+		}
+
+		void clear()
+		{
+			if (!_info->trivial)
+			{
+				for (size_t index{}; index < _size; ++index)
+				{
+					_info->destroy(address(index));
+				}
+			}
+
+			_size = 0;
+			changedTicks.clear();
+			addedTicks.clear();
+			changedBlocks.clear();
+			addedBlocks.clear();
+			writtenBlocks.clear();
+			_changed = 0;
+			_added = 0;
+		}
+
+		void compact()
+		{
+			if (!_policy.shrinks(_size, _capacity))
+			{
+				return;
+			}
+
+			size_t capacity{ _policy.shrink(_size) };
+
+			if (chunked())
+			{
+				while (!borrowed && !chunks.empty() && _capacity - _chunkCapacity >= capacity)
+				{
+					release(chunks.back(), _chunkCapacity);
+					chunks.pop_back();
+					_capacity -= _chunkCapacity;
+				}
+			}
+			else if (capacity < _capacity)
+			{
+				reallocate(capacity);
+			}
+
+			changedTicks.shrink_to_fit();
+			addedTicks.shrink_to_fit();
+			changedBlocks.shrink_to_fit();
+			addedBlocks.shrink_to_fit();
+			writtenBlocks.shrink_to_fit();
+		}
+
+		bool chunked() const
+		{
+			return _chunkCapacity != 0;
+		}
+
+		void* chunk(size_t index)
+		{
+			return chunks[index];
+		}
+
+	private:
+		void relocate(void* destination, void* source, bool release = true)
+		{
+			if (_info->trivial)
+			{
+				std::memcpy(destination, source, _info->size);
+			}
+			else
+			{
+				_info->move(destination, source);
+				if (release)
+				{
+					_info->destroy(source);
+				}
+			}
+		}
+
+		void permuteTicks(const std::vector<size_t>& order)
+		{
+			TickContainer changed{ _resource };
+			TickContainer added{ _resource };
+			changed.reserve(changedTicks.capacity());
+			added.reserve(addedTicks.capacity());
+
+			for (size_t index{}; index < _size; ++index)
+			{
+				changed.push_back(this->changed(order[index]));
+				added.push_back(addedTicks[order[index]]);
+			}
+
+			changedTicks = std::move(changed);
+			addedTicks = std::move(added);
+			std::fill(writtenBlocks.begin(), writtenBlocks.end(), 0);
+			std::fill(changedBlocks.begin(), changedBlocks.end(), 0);
+			std::fill(addedBlocks.begin(), addedBlocks.end(), 0);
+
+			for (size_t index{}; index < _size; ++index)
+			{
+				raise(index, changedTicks[index], addedTicks[index]);
+			}
+		}
+
+		std::byte* address(size_t index) const
+		{
+			if (chunked())
+			{
+				return chunks[index / _chunkCapacity] + (index % _chunkCapacity) * _info->size;
+			}
+			return chunks.front() + index * _info->size;
+		}
+
+		void* slot()
+		{
+			if (_size == _capacity)
+			{
+				if (borrowed)
+				{
+					throw std::logic_error{ "Borrowed chunks grow through their cluster" };
+				}
+				reserve(chunked() ? std::max(_size + 1, _policy.minimumCapacity) : _policy.grow(_capacity, _size + 1));
+			}
+			return address(_size);
+		}
+
+		void reserveTicks(size_t capacity)
+		{
+			size_t blocks{ (capacity + TICK_BLOCK - 1) / TICK_BLOCK };
+
+			changedTicks.reserve(capacity);
+			addedTicks.reserve(capacity);
+			changedBlocks.reserve(blocks);
+			addedBlocks.reserve(blocks);
+			writtenBlocks.reserve(blocks);
+		}
+
+		void pushTicks(Tick changed, Tick added)
+		{
+			size_t index{ changedTicks.size() };
+
+			if (index / TICK_BLOCK == changedBlocks.size())
+			{
+				changedBlocks.push_back(0);
+				addedBlocks.push_back(0);
+				writtenBlocks.push_back(0);
+			}
+			else
+			{
+				settle(index / TICK_BLOCK, changed);
+			}
+
+			changedTicks.push_back(changed);
+			addedTicks.push_back(added);
+			raise(index, changed, added);
+		}
+
+		void popTicks()
+		{
+			changedTicks.pop_back();
+			addedTicks.pop_back();
+
+			if (changedTicks.size() % TICK_BLOCK == 0)
+			{
+				changedBlocks.pop_back();
+				addedBlocks.pop_back();
+				writtenBlocks.pop_back();
+			}
+		}
+
+		void settle(size_t block, Tick tick)
+		{
+			if (writtenBlocks[block] > tick)
+			{
+				size_t end{ std::min((block + 1) * TICK_BLOCK, changedTicks.size()) };
+				for (size_t index{ block * TICK_BLOCK }; index < end; ++index)
+				{
+					changedTicks[index] = std::max(changedTicks[index], writtenBlocks[block]);
+				}
+				writtenBlocks[block] = 0;
+			}
+		}
+
+		void raise(size_t index, Tick changed, Tick added)
+		{
+			size_t block{ index / TICK_BLOCK };
+
+			changedBlocks[block] = std::max(changedBlocks[block], changed);
+			addedBlocks[block] = std::max(addedBlocks[block], added);
+			_changed = std::max(_changed, changed);
+			_added = std::max(_added, added);
+		}
+
+		void deallocate()
+		{
+			if (!borrowed)
+			{
+				for (auto chunk : chunks)
+				{
+					release(chunk, chunked() ? _chunkCapacity : _capacity);
+				}
+			}
+
+			chunks.clear();
+			_capacity = 0;
+		}
+
+		void reallocate(size_t capacity)
+		{
+			std::byte* buffer{ capacity > 0 ? allocate(capacity) : nullptr };
+
+			if (!chunks.empty())
+			{
+				std::byte* old{ chunks.front() };
+
+				if (_info->trivial && _size > 0)
+				{
+					std::memcpy(buffer, old, _size * _info->size);
+				}
+				else
+				{
+					for (size_t index{}; index < _size; ++index)
+					{
+						_info->move(buffer + index * _info->size, old + index * _info->size);
+						_info->destroy(old + index * _info->size);
+					}
+				}
+
+				release(old, _capacity);
+				chunks.clear();
+			}
+
+			if (buffer)
+			{
+				chunks.push_back(buffer);
+			}
+
+			_capacity = capacity;
+		}
+
+		std::byte* allocate(size_t count) const
+		{
+			return static_cast<std::byte*>(_resource->allocate(count * _info->size, alignment()));
+		}
+
+		void release(std::byte* chunk, size_t count) const
+		{
+			_resource->deallocate(chunk, count * _info->size, alignment());
+		}
+
+		size_t alignment() const
+		{
+			return std::max(ALIGNMENT, _info->alignment);
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,473 @@
+#ifndef BYTE_ECS_COMMAND_BUFFER_H
+#define BYTE_ECS_COMMAND_BUFFER_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <algorithm>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+#include "pool.h"
+#include "entity.h"
+#include "signature.h"
+#include "component.h"
+#include "typedefs.h"
+
+namespace Byte::ECS
+{
+
+	class CommandBuffer
+	{
+	private:
+		enum class CommandType : uint8_t
+		{
+			CREATE,
+			DESTROY,
+			ATTACH,
+			DETACH
+		};
+
+		using Apply = void(*)(Pool&, EntityID, void*);
+		using Destroy = void(*)(void*);
+
+		struct Command
+		{
+			CommandType type;
+			ComponentID component{ 0 };
+			EntityID entity{ nullent };
+			void* payload{ nullptr };
+			Apply apply{ nullptr };
+			Destroy destroy{ nullptr };
+			const ComponentInfo* info{ nullptr };
+			bool table{ false };
+		};
+
+		struct Block
+		{
+			std::unique_ptr<std::byte[]> data;
+			size_t size{ 0 };
+			size_t used{ 0 };
+		};
+
+		struct Entry
+		{
+			EntityID entity;
+			Signature signature;
+			bool destroyed{ false };
+			size_t hash{ 0 };
+		};
+
+		struct Step
+		{
+			Command* command;
+			size_t entry;
+		};
+
+		using CommandContainer = std::vector<Command>;
+		using PayloadContainer = std::vector<ComponentPayload>;
+		using BlockContainer = std::vector<Block>;
+		using EntityIDContainer = std::vector<EntityID>;
+
+		friend class CommandQueue;
+
+	private:
+		inline static constexpr size_t BLOCK_SIZE{ 16 * 1024 };
+		inline static std::atomic<size_t> nextID{ 0 };
+
+		CommandContainer commands;
+		BlockContainer blocks;
+		EntityIDContainer created;
+		size_t _id{ generate() };
+
+	public:
+		CommandBuffer() = default;
+
+		CommandBuffer(const CommandBuffer&) = delete;
+
+		CommandBuffer(CommandBuffer&& right) noexcept
+			:commands{ std::move(right.commands) }, blocks{ std::move(right.blocks) },
+			created{ std::move(right.created) }, _id{ right._id }
+		{
+			right.commands.clear();
+			right.created.clear();
+			right._id = generate();
+		}
+
+		CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+		CommandBuffer& operator=(CommandBuffer&& right) noexcept
+		{
+			clear();
+			commands = std::move(right.commands);
+			blocks = std::move(right.blocks);
+			created = std::move(right.created);
+			_id = right._id;
+
+			right.commands.clear();
+			right.created.clear();
+			right._id = generate();
+			return *this;
+		}
+
+		~CommandBuffer()
+		{
+			clear();
+		}
+
+		EntityID create()
+		{
+			EntityID out{ EntityHandle::placeholder(_id, created.size()) };
+			created.push_back(nullent);
+			commands.push_back(Command{ CommandType::CREATE, 0, out });
+			return out;
+		}
+
+		template<typename Type, typename... Types>
+		EntityID create(Type&& component, Types&&... components)
+		{
+			EntityID out{ create() };
+			attach(out, std::move(component), std::move(components)...);
+			return out;
+		}
+
+		void destroy(EntityID id)
+		{
+			commands.push_back(Command{ CommandType::DESTROY, 0, id });
+		}
+
+		template<typename Type, typename... Types>
+		void attach(EntityID id, Type&& component, Types&&... components)
+		{
+			push<Type>(id, std::move(component));
+			(push<Types>(id, std::move(components)), ...);
+		}
+
+		template<typename Type>
+		void detach(EntityID id)
+		{
+			Command command{ CommandType::DETACH, ComponentRegistry<Type>::id, id };
+			command.apply = [](Pool& pool, EntityID entity, void*)
+				{
+					pool.detach<Type>(entity);
+				};
+			command.table = !ComponentRegistry<Type>::sparse && !ComponentRegistry<Type>::shared;
+			commands.push_back(command);
+		}
+
+		void playback(Pool& pool)
+		{
+			CommandBuffer* buffer{ this };
+			playback(pool, &buffer, 1);
+		}
+
+		size_t size() const
+		{
+			return commands.size();
+		}
+
+		bool empty() const
+		{
+			return commands.empty();
+		}
+
+		size_t id() const
+		{
+			return _id;
+		}
+
+		void clear()
+		{
+			for (auto& command : commands)
+			{
+				if (command.destroy)
+				{
+					command.destroy(command.payload);
+				}
+			}
+
+			commands.clear();
+			created.clear();
+			_id = generate();
+
+			if (!blocks.empty())
+			{
+				blocks.erase(blocks.begin() + 1, blocks.end());
+				blocks.front().used = 0;
+			}
+		}
+
+	private:
+		template<typename Type>
+		void push(EntityID id, Type&& component)
+		{
+			Command command{ CommandType::ATTACH, ComponentRegistry<Type>::id, id };
+			command.payload = new (allocate(sizeof(Type), alignof(Type))) Type{ std::move(component) };
+			command.apply = [](Pool& pool, EntityID entity, void* payload)
+				{
+					pool.attach(entity, std::move(*static_cast<Type*>(payload)));
+				};
+			command.destroy = [](void* payload)
+				{
+					static_cast<Type*>(payload)->~Type();
+				};
+			command.info = &ComponentRegistry<Type>::info;
+			command.table = !ComponentRegistry<Type>::sparse && !ComponentRegistry<Type>::shared;
+			commands.push_back(command);
+		}
+
+		void* allocate(size_t size, size_t alignment)
+		{
+			if (!blocks.empty())
+			{
+				Block& block{ blocks.back() };
+				size_t offset{ (block.used + alignment - 1) & ~(alignment - 1) };
+				if (offset + size <= block.size)
+				{
+					block.used = offset + size;
+					return block.data.get() + offset;
+				}
+			}
+
+			size_t blockSize{ std::max(BLOCK_SIZE, size + alignment) };
+			Block block{ std::make_unique<std::byte[]>(blockSize), blockSize, 0 };
+
+			void* address{ block.data.get() };
+			size_t space{ blockSize };
+			std::align(alignment, size, address, space);
+			block.used = blockSize - space + size;
+
+			blocks.push_back(std::move(block));
+			return address;
+		}
+
+		static size_t generate()
+		{
+			return nextID++ & EntityHandle::MAX_VERSION;
+		}
+
+		static EntityID resolve(CommandBuffer** buffers, size_t count, EntityID id)
+		{
+			if (!EntityHandle::isPlaceholder(id))
+			{
+				return id;
+			}
+
+			size_t buffer{ EntityHandle::buffer(id) };
+			size_t slot{ EntityHandle::index(id) };
+			for (size_t index{}; index < count; ++index)
+			{
+				if (buffers[index]->_id == buffer)
+				{
+					const EntityIDContainer& created{ buffers[index]->created };
+					return slot < created.size() ? created[slot] : nullent;
+				}
+			}
+
+			return nullent;
+		}
+
+		static void playback(Pool& pool, CommandBuffer** buffers, size_t count)
+		{
+			std::vector<Entry> entries;
+			std::vector<Step> steps;
+			std::unordered_map<EntityID, size_t> lookup;
+
+			for (size_t index{}; index < count; ++index)
+			{
+				for (auto& id : buffers[index]->created)
+				{
+					id = pool.create();
+				}
+			}
+
+			for (size_t index{}; index < count; ++index)
+			{
+				for (auto& command : buffers[index]->commands)
+				{
+					command.entity = resolve(buffers, count, command.entity);
+
+					if (command.type == CommandType::CREATE || !pool.contains(command.entity))
+					{
+						continue;
+					}
+
+					auto [result, inserted] { lookup.try_emplace(command.entity, entries.size()) };
+					if (inserted)
+					{
+						entries.push_back(Entry{ command.entity, pool.signature(command.entity) });
+					}
+
+					Entry& entry{ entries[result->second] };
+					if (command.type == CommandType::DESTROY)
+					{
+						entry.destroyed = true;
+					}
+					else if (command.table)
+					{
+						entry.signature.set(command.component, command.type == CommandType::ATTACH);
+					}
+
+					steps.push_back(Step{ &command, result->second });
+				}
+			}
+
+			for (auto& entry : entries)
+			{
+				entry.hash = entry.destroyed ? 0 : std::hash<Signature>{}(entry.signature);
+			}
+
+			std::stable_sort(steps.begin(), steps.end(), [&](const Step& left, const Step& right)
+				{
+					const Entry& leftEntry{ entries[left.entry] };
+					const Entry& rightEntry{ entries[right.entry] };
+
+					if (leftEntry.hash != rightEntry.hash)
+					{
+						return leftEntry.hash < rightEntry.hash;
+					}
+					return left.entry < right.entry;
+				});
+
+			PayloadContainer payloads;
+			for (size_t begin{}; begin < steps.size();)
+			{
+				size_t end{ begin + 1 };
+				while (end < steps.size() && steps[end].entry == steps[begin].entry)
+				{
+					++end;
+				}
+
+				const Entry& entry{ entries[steps[begin].entry] };
+				if (entry.destroyed)
+				{
+					pool.destroy(entry.entity);
+					begin = end;
+					continue;
+				}
+
+				payloads.clear();
+				bool table{ false };
+
+				for (size_t index{ begin }; index < end; ++index)
+				{
+					const Command& command{ *steps[index].command };
+					if (!command.table)
+					{
+						continue;
+					}
+
+					table = true;
+					std::erase_if(payloads, [&](const ComponentPayload& payload)
+						{
+							return payload.id == command.component;
+						});
+
+					if (command.type == CommandType::ATTACH)
+					{
+						payloads.push_back(ComponentPayload{ command.component, command.info, command.payload });
+					}
+				}
+
+				if (table)
+				{
+					pool.place(entry.entity, entry.signature, payloads);
+				}
+
+				for (size_t index{ begin }; index < end; ++index)
+				{
+					Command& command{ *steps[index].command };
+					if (!command.table)
+					{
+						command.apply(pool, command.entity, command.payload);
+					}
+				}
+
+				begin = end;
+			}
+
+			for (size_t index{}; index < count; ++index)
+			{
+				buffers[index]->clear();
+			}
+		}
+	};
+
+	class CommandQueue
+	{
+	private:
+		struct LocalCache
+		{
+			uint64_t serial;
+			CommandBuffer* buffer;
+		};
+
+		using BufferContainer = std::vector<std::unique_ptr<CommandBuffer>>;
+		using ThreadMap = std::unordered_map<std::thread::id, CommandBuffer*>;
+
+	private:
+		inline static std::atomic<uint64_t> nextSerial{ 1 };
+		inline static thread_local LocalCache cache;
+
+		BufferContainer buffers;
+		ThreadMap threads;
+		std::mutex mutex;
+		uint64_t serial{ nextSerial++ };
+
+	public:
+		CommandQueue() = default;
+
+		CommandQueue(const CommandQueue&) = delete;
+
+		CommandQueue& operator=(const CommandQueue&) = delete;
+
+		CommandBuffer& local()
+		{
+			if (cache.serial == serial)
+			{
+				return *cache.buffer;
+			}
+
+			std::lock_guard<std::mutex> lock{ mutex };
+
+			CommandBuffer*& buffer{ threads[std::this_thread::get_id()] };
+			if (!buffer)
+			{
+				buffers.push_back(std::make_unique<CommandBuffer>());
+				buffer = buffers.back().get();
+			}
+
+			cache = LocalCache{ serial, buffer };
+			return *buffer;
+		}
+
+		void playback(Pool& pool)
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+
+			std::vector<CommandBuffer*> pointers;
+			for (auto& buffer : buffers)
+			{
+				pointers.push_back(buffer.get());
+			}
+
+			CommandBuffer::playback(pool, pointers.data(), pointers.size());
+		}
+
+		void clear()
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			for (auto& buffer : buffers)
+			{
+				buffer->clear();
+			}
+		}
+	};
+
+}
+
+#endif
@@ -3,12 +3,68 @@
 
 #include <memory>
 #include <vector>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
 
 #include "typedefs.h"
 
 namespace Byte::ECS
 {
 
+	struct ComponentInfo
+	{
+		using Construct = void(*)(void*);
+		using Move = void(*)(void*, void*);
+		using Copy = void(*)(void*, const void*);
+		using Destroy = void(*)(void*);
+
+		size_t size{ 0 };
+		size_t alignment{ 0 };
+		bool trivial{ false };
+		bool tag{ false };
+		Construct construct{ nullptr };
+		Move move{ nullptr };
+		Copy copy{ nullptr };
+		Destroy destroy{ nullptr };
+
+		template<typename Component>
+		static constexpr ComponentInfo make()
+		{
+			ComponentInfo out{ sizeof(Component), alignof(Component), std::is_trivially_copyable_v<Component>,
+				std::is_empty_v<Component> && std::is_trivially_destructible_v<Component> };
+
+			if constexpr (std::is_default_constructible_v<Component>)
+			{
+				out.construct = [](void* destination)
+					{
+						::new (destination) Component();
+					};
+			}
+
+			if constexpr (std::is_copy_constructible_v<Component>)
+			{
+				out.copy = [](void* destination, const void* source)
+					{
+						::new (destination) Component(*static_cast<const Component*>(source));
+					};
+			}
+
+			out.move = [](void* destination, void* source)
+				{
+					::new (destination) Component(std::move(*static_cast<Component*>(source)));
+				};
+
+			out.destroy = [](void* item)
+				{
+					static_cast<Component*>(item)->~Component();
+				};
+
+			return out;
+		}
+	};
+
 	struct ComponentIDGenerator
 	{
 	private:
@@ -22,10 +78,32 @@ namespace Byte::ECS
 		}
 	};
 
+	enum class ComponentStorage : uint8_t
+	{
+		TABLE,
+		SPARSE,
+		SHARED
+	};
+
+	template<typename Component>
+	struct ComponentTraits
+	{
+		inline static constexpr ComponentStorage storage{ ComponentStorage::TABLE };
+	};
+
 	template<typename Component>
 	struct ComponentRegistry
 	{	
 		inline static const ComponentID id{ ComponentIDGenerator::generate<Component>() };
+		inline static constexpr ComponentInfo info{ ComponentInfo::make<Component>() };
+		inline static constexpr bool sparse{ ComponentTraits<Component>::storage == ComponentStorage::SPARSE };
+		inline static constexpr bool shared{ ComponentTraits<Component>::storage == ComponentStorage::SHARED };
+		inline static constexpr bool tag{ info.tag && ComponentTraits<Component>::storage == ComponentStorage::TABLE };
+	};
+
+	template<typename Component>
+	struct ComponentRegistry<const Component> : ComponentRegistry<Component>
+	{
 	};
 
 }
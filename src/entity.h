@@ -0,0 +1,56 @@
+#ifndef BYTE_ECS_ENTITY_H
+#define BYTE_ECS_ENTITY_H
+
+#include <limits>
+
+#include "typedefs.h"
+
+namespace Byte::ECS
+{
+
+	struct EntityHandle
+	{
+		inline static constexpr size_t VERSION_SHIFT{ 32 };
+		inline static constexpr EntityID INDEX_MASK{ (EntityID{ 1 } << VERSION_SHIFT) - 1 };
+		inline static constexpr EntityVersion MAX_VERSION{ std::numeric_limits<EntityVersion>::max() >> 1 };
+		inline static constexpr EntityID PLACEHOLDER_FLAG{ EntityID{ 1 } << 63 };
+
+		static constexpr EntityID make(size_t index, EntityVersion version)
+		{
+			return (static_cast<EntityID>(version) << VERSION_SHIFT) | (static_cast<EntityID>(index) & INDEX_MASK);
+		}
+
+		static constexpr size_t index(EntityID id)
+		{
+			return static_cast<size_t>(id & INDEX_MASK);
+		}
+
+		static constexpr EntityVersion version(EntityID id)
+		{
+			return static_cast<EntityVersion>(id >> VERSION_SHIFT);
+		}
+
+		static constexpr EntityVersion next(EntityVersion version)
+		{
+			return version == MAX_VERSION ? 0 : version + 1;
+		}
+
+		static constexpr EntityID placeholder(size_t buffer, size_t index)
+		{
+			return PLACEHOLDER_FLAG | make(index, static_cast<EntityVersion>(buffer));
+		}
+
+		static constexpr bool isPlaceholder(EntityID id)
+		{
+			return id != nullent && (id & PLACEHOLDER_FLAG) != 0;
+		}
+
+		static constexpr size_t buffer(EntityID id)
+		{
+			return static_cast<size_t>(version(id & ~PLACEHOLDER_FLAG));
+		}
+	};
+
+}
+
+#endif
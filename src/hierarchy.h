@@ -0,0 +1,272 @@
+#ifndef BYTE_ECS_HIERARCHY_H
+#define BYTE_ECS_HIERARCHY_H
+
+#include <vector>
+#include <memory_resource>
+#include <stdexcept>
+#include <cstdint>
+
+#include "entity.h"
+#include "typedefs.h"
+
+namespace Byte::ECS
+{
+
+	struct HierarchyNode
+	{
+		EntityID id{ nullent };
+		EntityID parent{ nullent };
+		EntityID firstChild{ nullent };
+		EntityID previousSibling{ nullent };
+		EntityID nextSibling{ nullent };
+	};
+
+	class Hierarchy
+	{
+	private:
+		using NodeContainer = std::pmr::vector<HierarchyNode>;
+		using EntityIDContainer = std::pmr::vector<EntityID>;
+		using LevelContainer = std::pmr::vector<size_t>;
+		using PositionContainer = std::pmr::vector<size_t>;
+
+	public:
+		inline static constexpr size_t NONE{ SIZE_MAX };
+
+	private:
+		NodeContainer nodes;
+		EntityIDContainer _order;
+		LevelContainer _levels;
+		PositionContainer _parents;
+		PositionContainer _positions;
+		bool dirty{ false };
+
+	public:
+		Hierarchy(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			:nodes{ resource }, _order{ resource }, _levels{ resource }, _parents{ resource }, _positions{ resource }
+		{
+		}
+
+		EntityID parent(EntityID id) const
+		{
+			const HierarchyNode* node{ find(id) };
+			return node ? node->parent : nullent;
+		}
+
+		EntityID firstChild(EntityID id) const
+		{
+			const HierarchyNode* node{ find(id) };
+			return node ? node->firstChild : nullent;
+		}
+
+		EntityID nextSibling(EntityID id) const
+		{
+			const HierarchyNode* node{ find(id) };
+			return node ? node->nextSibling : nullent;
+		}
+
+		void link(EntityID child, EntityID parent)
+		{
+			for (EntityID current{ parent }; current != nullent; current = this->parent(current))
+			{
+				if (current == child)
+				{
+					throw std::logic_error{ "Entity cannot be parented to itself or its descendants" };
+				}
+			}
+
+			HierarchyNode& node{ at(child) };
+			if (node.parent == parent)
+			{
+				return;
+			}
+
+			unlink(node);
+
+			HierarchyNode& parentNode{ at(parent) };
+			HierarchyNode& childNode{ at(child) };
+			childNode.parent = parent;
+			childNode.nextSibling = parentNode.firstChild;
+			if (parentNode.firstChild != nullent)
+			{
+				at(parentNode.firstChild).previousSibling = child;
+			}
+			parentNode.firstChild = child;
+			dirty = true;
+		}
+
+		void unlink(EntityID child)
+		{
+			HierarchyNode* node{ find(child) };
+			if (node)
+			{
+				unlink(*node);
+			}
+		}
+
+		void erase(EntityID id)
+		{
+			HierarchyNode* node{ find(id) };
+			if (!node)
+			{
+				return;
+			}
+
+			unlink(*node);
+
+			for (EntityID child{ node->firstChild }; child != nullent;)
+			{
+				HierarchyNode& childNode{ at(child) };
+				child = childNode.nextSibling;
+				childNode.parent = nullent;
+				childNode.previousSibling = nullent;
+				childNode.nextSibling = nullent;
+			}
+
+			*node = HierarchyNode{};
+			dirty = true;
+		}
+
+		void clear()
+		{
+			nodes.clear();
+			_order.clear();
+			_levels.clear();
+			_parents.clear();
+			_positions.clear();
+			dirty = false;
+		}
+
+		const EntityIDContainer& order()
+		{
+			update();
+			return _order;
+		}
+
+		const LevelContainer& levels()
+		{
+			update();
+			return _levels;
+		}
+
+		const PositionContainer& parents()
+		{
+			update();
+			return _parents;
+		}
+
+		size_t position(EntityID id)
+		{
+			update();
+			size_t index{ EntityHandle::index(id) };
+			return index < _positions.size() && nodes[index].id == id ? _positions[index] : NONE;
+		}
+
+	private:
+		const HierarchyNode* find(EntityID id) const
+		{
+			size_t index{ EntityHandle::index(id) };
+			return index < nodes.size() && nodes[index].id == id ? &nodes[index] : nullptr;
+		}
+
+		HierarchyNode* find(EntityID id)
+		{
+			size_t index{ EntityHandle::index(id) };
+			return index < nodes.size() && nodes[index].id == id ? &nodes[index] : nullptr;
+		}
+
+		HierarchyNode& at(EntityID id)
+		{
+			size_t index{ EntityHandle::index(id) };
+			if (index >= nodes.size())
+			{
+				nodes.resize(index + 1);
+			}
+
+			HierarchyNode& node{ nodes[index] };
+			if (node.id != id)
+			{
+				node = HierarchyNode{ id };
+			}
+			return node;
+		}
+
+		void unlink(HierarchyNode& node)
+		{
+			if (node.parent == nullent)
+			{
+				return;
+			}
+
+			if (node.previousSibling != nullent)
+			{
+				at(node.previousSibling).nextSibling = node.nextSibling;
+			}
+			else
+			{
+				at(node.parent).firstChild = node.nextSibling;
+			}
+
+			if (node.nextSibling != nullent)
+			{
+				at(node.nextSibling).previousSibling = node.previousSibling;
+			}
+
+			node.parent = nullent;
+			node.previousSibling = nullent;
+			node.nextSibling = nullent;
+			dirty = true;
+		}
+
+		void update()
+		{
+			if (!dirty)
+			{
+				return;
+			}
+
+			_order.clear();
+			_levels.clear();
+			_parents.clear();
+
+			for (auto& node : nodes)
+			{
+				if (node.id != nullent && node.parent == nullent && node.firstChild != nullent)
+				{
+					_order.push_back(node.id);
+					_parents.push_back(NONE);
+				}
+			}
+
+			size_t begin{ 0 };
+			while (begin < _order.size())
+			{
+				size_t end{ _order.size() };
+				_levels.push_back(begin);
+
+				for (size_t index{ begin }; index < end; ++index)
+				{
+					for (EntityID child{ nodes[EntityHandle::index(_order[index])].firstChild }; child != nullent;
+						child = nodes[EntityHandle::index(child)].nextSibling)
+					{
+						_order.push_back(child);
+						_parents.push_back(index);
+					}
+				}
+
+				begin = end;
+			}
+
+			_levels.push_back(_order.size());
+
+			_positions.assign(nodes.size(), NONE);
+			for (size_t index{}; index < _order.size(); ++index)
+			{
+				_positions[EntityHandle::index(_order[index])] = index;
+			}
+			dirty = false;
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,358 @@
+#ifndef BYTE_ECS_INDEX_H
+#define BYTE_ECS_INDEX_H
+
+#include <unordered_map>
+#include <map>
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <variant>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+
+#include "component.h"
+#include "typedefs.h"
+
+namespace Byte::ECS
+{
+
+	enum class IndexKind : uint8_t
+	{
+		HASH,
+		ORDERED
+	};
+
+	using KeyValue = std::variant<std::monostate, intmax_t, uintmax_t, long double, std::string_view>;
+
+	template<typename Key>
+	KeyValue keyValue(const Key& key)
+	{
+		if constexpr (std::is_integral_v<Key> && std::is_signed_v<Key>)
+		{
+			return static_cast<intmax_t>(key);
+		}
+		else if constexpr (std::is_integral_v<Key>)
+		{
+			return static_cast<uintmax_t>(key);
+		}
+		else if constexpr (std::is_floating_point_v<Key>)
+		{
+			return static_cast<long double>(key);
+		}
+		else if constexpr (std::is_convertible_v<const Key&, std::string_view>)
+		{
+			return std::string_view{ key };
+		}
+		else
+		{
+			return std::monostate{};
+		}
+	}
+
+	class ComponentIndex
+	{
+	public:
+		virtual ~ComponentIndex() = default;
+
+		virtual void insert(EntityID id, const void* component) = 0;
+		virtual void erase(EntityID id) = 0;
+		virtual void clear() = 0;
+
+		virtual std::span<const EntityID> lookup(const KeyValue& key) const = 0;
+		virtual std::vector<EntityID> lookup(const KeyValue& low, const KeyValue& high) const = 0;
+	};
+
+	template<typename Key>
+	class KeyIndex : public ComponentIndex
+	{
+	public:
+		inline static const char TAG{};
+
+	public:
+		virtual std::span<const EntityID> find(const Key& key) const = 0;
+		virtual std::vector<EntityID> range(const Key& low, const Key& high) const = 0;
+
+		std::span<const EntityID> lookup(const KeyValue& key) const override
+		{
+			return find(convert(key));
+		}
+
+		std::vector<EntityID> lookup(const KeyValue& low, const KeyValue& high) const override
+		{
+			return range(convert(low), convert(high));
+		}
+
+	private:
+		static Key convert(const KeyValue& key)
+		{
+			return std::visit([](const auto& value) -> Key
+				{
+					using Value = std::remove_cvref_t<decltype(value)>;
+
+					if constexpr (std::is_integral_v<Key> && (std::is_same_v<Value, intmax_t> || std::is_same_v<Value, uintmax_t>))
+					{
+						Key out{ static_cast<Key>(value) };
+						if (static_cast<Value>(out) != value || (out < Key{}) != (value < Value{}))
+						{
+							throw std::out_of_range{ "Key does not fit the index key type" };
+						}
+						return out;
+					}
+					else if constexpr (std::is_floating_point_v<Key> && std::is_arithmetic_v<Value>)
+					{
+						return static_cast<Key>(value);
+					}
+					else if constexpr (!std::is_arithmetic_v<Key> && !std::is_same_v<Value, std::monostate> && std::is_constructible_v<Key, const Value&>)
+					{
+						return Key(value);
+					}
+					else
+					{
+						throw std::invalid_argument{ "Key type does not match the index" };
+					}
+				}, key);
+		}
+	};
+
+	template<typename Type, typename Key, typename Extractor, IndexKind Kind>
+	class ValueIndex final : public KeyIndex<Key>
+	{
+	private:
+		using Bucket = std::pmr::vector<EntityID>;
+		using BucketContainer = std::conditional_t<Kind == IndexKind::ORDERED,
+			std::pmr::map<Key, Bucket>, std::pmr::unordered_map<Key, Bucket>>;
+
+		struct Slot
+		{
+			Key key;
+			size_t position;
+		};
+
+		using SlotContainer = std::pmr::unordered_map<EntityID, Slot>;
+
+	private:
+		Extractor extractor;
+		BucketContainer buckets;
+		SlotContainer slots;
+
+	public:
+		ValueIndex(const Extractor& extractor, std::pmr::memory_resource* resource)
+			:extractor{ extractor }, buckets{ resource }, slots{ resource }
+		{
+		}
+
+		void insert(EntityID id, const void* component) override
+		{
+			Key key{ extractor(*static_cast<const Type*>(component)) };
+
+			auto slot{ slots.find(id) };
+			if (slot != slots.end())
+			{
+				if (slot->second.key == key)
+				{
+					return;
+				}
+				remove(slot);
+			}
+
+			Bucket& bucket{ buckets.try_emplace(key).first->second };
+			slots.emplace(id, Slot{ std::move(key), bucket.size() });
+			bucket.push_back(id);
+		}
+
+		void erase(EntityID id) override
+		{
+			auto slot{ slots.find(id) };
+			if (slot != slots.end())
+			{
+				remove(slot);
+			}
+		}
+
+		void clear() override
+		{
+			buckets.clear();
+			slots.clear();
+		}
+
+		std::span<const EntityID> find(const Key& key) const override
+		{
+			auto result{ buckets.find(key) };
+			if (result == buckets.end())
+			{
+				return {};
+			}
+			return std::span<const EntityID>{ result->second };
+		}
+
+		std::vector<EntityID> range(const Key& low, const Key& high) const override
+		{
+			if constexpr (Kind == IndexKind::ORDERED)
+			{
+				std::vector<EntityID> out;
+				for (auto current{ buckets.lower_bound(low) }; current != buckets.end() && !(high < current->first); ++current)
+				{
+					out.insert(out.end(), current->second.begin(), current->second.end());
+				}
+				return out;
+			}
+			else
+			{
+				throw std::logic_error{ "Hash indexes do not support range queries" };
+			}
+		}
+
+	private:
+		void remove(typename SlotContainer::iterator slot)
+		{
+			auto bucket{ buckets.find(slot->second.key) };
+			Bucket& ids{ bucket->second };
+			size_t position{ slot->second.position };
+
+			EntityID last{ ids.back() };
+			ids[position] = last;
+			slots.find(last)->second.position = position;
+			ids.pop_back();
+
+			if (ids.empty())
+			{
+				buckets.erase(bucket);
+			}
+			slots.erase(slot);
+		}
+	};
+
+	class IndexRegistry
+	{
+	private:
+		struct Entry
+		{
+			std::unique_ptr<ComponentIndex> index;
+			const void* tag{ nullptr };
+		};
+
+		using EntryContainer = std::pmr::unordered_map<ComponentID, Entry>;
+
+	private:
+		std::pmr::memory_resource* _resource;
+		EntryContainer entries;
+
+	public:
+		IndexRegistry(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			:_resource{ resource }, entries{ resource }
+		{
+		}
+
+		template<typename Type, IndexKind Kind, typename Extractor>
+		ComponentIndex& emplace(const Extractor& extractor)
+		{
+			using Key = std::remove_cvref_t<std::invoke_result_t<const Extractor&, const Type&>>;
+
+			Entry& entry{ entries[ComponentRegistry<Type>::id] };
+			entry.index = std::make_unique<ValueIndex<Type, Key, Extractor, Kind>>(extractor, _resource);
+			entry.tag = &KeyIndex<Key>::TAG;
+			return *entry.index;
+		}
+
+		template<typename Type, typename Key>
+		const KeyIndex<Key>& get() const
+		{
+			const Entry& entry{ at<Type>() };
+			if (entry.tag != &KeyIndex<Key>::TAG)
+			{
+				throw std::invalid_argument{ "Key type does not match the index" };
+			}
+			return static_cast<const KeyIndex<Key>&>(*entry.index);
+		}
+
+		template<typename Type, typename Key>
+		std::span<const EntityID> lookup(const Key& key) const
+		{
+			const Entry& entry{ at<Type>() };
+			if (entry.tag == &KeyIndex<std::decay_t<const Key&>>::TAG)
+			{
+				return static_cast<const KeyIndex<std::decay_t<const Key&>>&>(*entry.index).find(key);
+			}
+			return entry.index->lookup(keyValue(key));
+		}
+
+		template<typename Type, typename Key>
+		std::vector<EntityID> lookup(const Key& low, const Key& high) const
+		{
+			const Entry& entry{ at<Type>() };
+			if (entry.tag == &KeyIndex<std::decay_t<const Key&>>::TAG)
+			{
+				return static_cast<const KeyIndex<std::decay_t<const Key&>>&>(*entry.index).range(low, high);
+			}
+			return entry.index->lookup(keyValue(low), keyValue(high));
+		}
+
+		ComponentIndex* find(ComponentID id)
+		{
+			auto result{ entries.find(id) };
+			return result != entries.end() ? result->second.index.get() : nullptr;
+		}
+
+		template<typename Callable>
+		void each(const Callable& callable)
+		{
+			for (auto& pair : entries)
+			{
+				callable(pair.first, *pair.second.index);
+			}
+		}
+
+		bool empty() const
+		{
+			return entries.empty();
+		}
+
+		template<typename Type>
+		bool erase()
+		{
+			return entries.erase(ComponentRegistry<Type>::id) != 0;
+		}
+
+		void erase(EntityID id)
+		{
+			for (auto& pair : entries)
+			{
+				pair.second.index->erase(id);
+			}
+		}
+
+		void erase(EntityID id, ComponentID component)
+		{
+			if (ComponentIndex* index{ find(component) })
+			{
+				index->erase(id);
+			}
+		}
+
+		void clear()
+		{
+			for (auto& pair : entries)
+			{
+				pair.second.index->clear();
+			}
+		}
+
+	private:
+		template<typename Type>
+		const Entry& at() const
+		{
+			auto result{ entries.find(ComponentRegistry<Type>::id) };
+			if (result == entries.end())
+			{
+				throw std::out_of_range{ "Component is not indexed" };
+			}
+			return result->second;
+		}
+	};
+
+}
+
+#endif
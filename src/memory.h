@@ -0,0 +1,82 @@
+#ifndef BYTE_ECS_MEMORY_H
+#define BYTE_ECS_MEMORY_H
+
+#include <memory_resource>
+#include <cstddef>
+
+#include "cluster.h"
+
+namespace Byte::ECS
+{
+
+	class MonotonicMemory
+	{
+	private:
+		std::pmr::monotonic_buffer_resource _resource;
+
+	public:
+		inline static constexpr size_t DEFAULT_SIZE{ 1024 * 1024 };
+
+	public:
+		MonotonicMemory(size_t initialSize = DEFAULT_SIZE,
+			std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+			:_resource{ initialSize, upstream }
+		{
+		}
+
+		MonotonicMemory(const MonotonicMemory&) = delete;
+		MonotonicMemory& operator=(const MonotonicMemory&) = delete;
+
+		std::pmr::memory_resource* resource()
+		{
+			return &_resource;
+		}
+
+		operator std::pmr::memory_resource*()
+		{
+			return &_resource;
+		}
+
+		void release()
+		{
+			_resource.release();
+		}
+	};
+
+	class PooledMemory
+	{
+	private:
+		std::pmr::unsynchronized_pool_resource _resource;
+
+	public:
+		inline static constexpr size_t DEFAULT_BLOCK{ Cluster::CHUNK_SIZE };
+
+	public:
+		PooledMemory(size_t largestBlock = DEFAULT_BLOCK,
+			std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+			:_resource{ std::pmr::pool_options{ 0, largestBlock }, upstream }
+		{
+		}
+
+		PooledMemory(const PooledMemory&) = delete;
+		PooledMemory& operator=(const PooledMemory&) = delete;
+
+		std::pmr::memory_resource* resource()
+		{
+			return &_resource;
+		}
+
+		operator std::pmr::memory_resource*()
+		{
+			return &_resource;
+		}
+
+		void release()
+		{
+			_resource.release();
+		}
+	};
+
+}
+
+#endif
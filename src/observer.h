@@ -0,0 +1,229 @@
+#ifndef BYTE_ECS_OBSERVER_H
+#define BYTE_ECS_OBSERVER_H
+
+#include <vector>
+#include <span>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "signature.h"
+#include "component.h"
+#include "typedefs.h"
+
+namespace Byte::ECS
+{
+
+	class ObserverRegistry
+	{
+	public:
+		using Callback = std::function<void(std::span<const EntityID>)>;
+
+	private:
+		struct Event
+		{
+			EntityID id;
+			bool added;
+		};
+
+		using CallbackContainer = std::vector<Callback>;
+		using EventContainer = std::vector<Event>;
+		using IDContainer = std::vector<EntityID>;
+
+		struct ComponentObservers
+		{
+			CallbackContainer add;
+			CallbackContainer remove;
+			EventContainer events;
+			size_t added{ 0 };
+		};
+
+		using ObserverContainer = std::vector<ComponentObservers>;
+
+	private:
+		ObserverContainer observers;
+		Signature observed;
+		Signature pending;
+
+	public:
+		template<typename Type>
+		void onAdd(Callback callback)
+		{
+			component(ComponentRegistry<Type>::id).add.push_back(std::move(callback));
+		}
+
+		template<typename Type>
+		void onRemove(Callback callback)
+		{
+			component(ComponentRegistry<Type>::id).remove.push_back(std::move(callback));
+		}
+
+		void added(EntityID id, ComponentID component)
+		{
+			record(id, component, true);
+		}
+
+		void removed(EntityID id, ComponentID component)
+		{
+			record(id, component, false);
+		}
+
+		void added(EntityID id, const Signature& components)
+		{
+			record(std::span<const EntityID>{ &id, 1 }, components, true);
+		}
+
+		void removed(EntityID id, const Signature& components)
+		{
+			record(std::span<const EntityID>{ &id, 1 }, components, false);
+		}
+
+		void added(std::span<const EntityID> ids, const Signature& components)
+		{
+			record(ids, components, true);
+		}
+
+		void removed(std::span<const EntityID> ids, const Signature& components)
+		{
+			record(ids, components, false);
+		}
+
+		void flush()
+		{
+			Signature batch{ pending };
+			pending.clear();
+
+			batch.each([this](ComponentID id)
+				{
+					EventContainer events;
+					events.swap(observers[id].events);
+
+					size_t added{ observers[id].added };
+					observers[id].added = 0;
+
+					IDContainer addedIDs;
+					IDContainer removedIDs;
+					resolve(events, added, addedIDs, removedIDs);
+
+					deliver(id, &ComponentObservers::remove, removedIDs);
+					deliver(id, &ComponentObservers::add, addedIDs);
+
+					events.clear();
+					if (observers[id].events.empty())
+					{
+						observers[id].events.swap(events);
+					}
+				});
+		}
+
+	private:
+		ComponentObservers& component(ComponentID id)
+		{
+			if (id >= observers.size())
+			{
+				observers.resize(static_cast<size_t>(id) + 1);
+			}
+
+			observed.set(id);
+			return observers[id];
+		}
+
+		void record(EntityID id, ComponentID component, bool added)
+		{
+			if (observed.test(component))
+			{
+				push(id, component, added);
+			}
+		}
+
+		void record(std::span<const EntityID> ids, const Signature& components, bool added)
+		{
+			if (ids.empty() || !observed.matches(components))
+			{
+				return;
+			}
+
+			(observed & components).each([&](ComponentID component)
+				{
+					for (auto id : ids)
+					{
+						push(id, component, added);
+					}
+				});
+		}
+
+		void push(EntityID id, ComponentID component, bool added)
+		{
+			ComponentObservers& target{ observers[component] };
+			target.events.push_back(Event{ id, added });
+			target.added += added;
+			pending.set(component);
+		}
+
+		static void resolve(const EventContainer& events, size_t added, IDContainer& addedIDs, IDContainer& removedIDs)
+		{
+			if (added == events.size() || added == 0)
+			{
+				IDContainer& out{ added ? addedIDs : removedIDs };
+				out.reserve(events.size());
+				for (auto& event : events)
+				{
+					out.push_back(event.id);
+				}
+				return;
+			}
+
+			struct Net
+			{
+				bool present;
+				int balance;
+			};
+
+			std::unordered_map<EntityID, Net> net;
+			for (auto& event : events)
+			{
+				Net& current{ net.try_emplace(event.id, Net{ !event.added, 0 }).first->second };
+				current.balance += event.added ? 1 : -1;
+			}
+
+			for (auto& event : events)
+			{
+				auto result{ net.find(event.id) };
+				if (result == net.end())
+				{
+					continue;
+				}
+
+				bool present{ result->second.present };
+				bool remains{ result->second.balance > 0 || (result->second.balance == 0 && present) };
+
+				if (present)
+				{
+					removedIDs.push_back(event.id);
+				}
+				if (remains)
+				{
+					addedIDs.push_back(event.id);
+				}
+
+				net.erase(result);
+			}
+		}
+
+		void deliver(ComponentID id, CallbackContainer ComponentObservers::* callbacks, const IDContainer& ids)
+		{
+			if (ids.empty())
+			{
+				return;
+			}
+
+			for (size_t index{}; index < (observers[id].*callbacks).size(); ++index)
+			{
+				(observers[id].*callbacks)[index](std::span<const EntityID>{ ids });
+			}
+		}
+	};
+
+}
+
+#endif
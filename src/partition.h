@@ -0,0 +1,94 @@
+#ifndef BYTE_ECS_PARTITION_H
+#define BYTE_ECS_PARTITION_H
+
+#include <vector>
+#include <tuple>
+#include <algorithm>
+
+#include "cluster.h"
+#include "typedefs.h"
+
+namespace Byte::ECS
+{
+
+	struct ClusterRange
+	{
+		Cluster* cluster{ nullptr };
+		size_t begin{ 0 };
+		size_t end{ 0 };
+	};
+
+	class ClusterPartition
+	{
+	private:
+		using RangeContainer = std::vector<ClusterRange>;
+		using OffsetContainer = std::vector<size_t>;
+
+	private:
+		RangeContainer ranges;
+		OffsetContainer offsets;
+
+	public:
+		ClusterPartition(const ClusterGroup& clusters, size_t grain)
+		{
+			grain = std::max<size_t>(grain, 1);
+
+			RangeContainer remainders;
+			for (auto cluster : clusters)
+			{
+				size_t size{ cluster->size() };
+				size_t begin{ 0 };
+				size_t step{ grain };
+
+				if (cluster->chunked())
+				{
+					size_t capacity{ cluster->chunkCapacity() };
+					step = std::max(grain - grain % capacity, capacity);
+				}
+
+				for (; size - begin >= step; begin += step)
+				{
+					offsets.push_back(ranges.size());
+					ranges.push_back(ClusterRange{ cluster, begin, begin + step });
+				}
+
+				if (begin != size)
+				{
+					remainders.push_back(ClusterRange{ cluster, begin, size });
+				}
+			}
+
+			size_t rows{ grain };
+			for (auto& range : remainders)
+			{
+				if (rows >= grain)
+				{
+					offsets.push_back(ranges.size());
+					rows = 0;
+				}
+
+				ranges.push_back(range);
+				rows += range.end - range.begin;
+			}
+
+			offsets.push_back(ranges.size());
+		}
+
+		size_t size() const
+		{
+			return offsets.size() - 1;
+		}
+
+		template<typename Callable>
+		void each(size_t task, const Callable& callable) const
+		{
+			for (size_t index{ offsets[task] }; index < offsets[task + 1]; ++index)
+			{
+				callable(ranges[index]);
+			}
+		}
+	};
+
+}
+
+#endif
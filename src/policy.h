@@ -0,0 +1,36 @@
+#ifndef BYTE_ECS_POLICY_H
+#define BYTE_ECS_POLICY_H
+
+#include <algorithm>
+#include <cstddef>
+
+namespace Byte::ECS
+{
+
+	struct GrowthPolicy
+	{
+		float growth{ 2.0f };
+		float shrinkLoad{ 0.25f };
+		float hysteresis{ 0.5f };
+		size_t minimumCapacity{ 0 };
+
+		size_t grow(size_t capacity, size_t required) const
+		{
+			size_t grown{ static_cast<size_t>(capacity * std::max(growth, 1.0f)) };
+			return std::max({ required, grown, minimumCapacity });
+		}
+
+		bool shrinks(size_t size, size_t capacity) const
+		{
+			return capacity > minimumCapacity && size < capacity * shrinkLoad;
+		}
+
+		size_t shrink(size_t size) const
+		{
+			return std::max(minimumCapacity, size + static_cast<size_t>(size * hysteresis));
+		}
+	};
+
+}
+
+#endif
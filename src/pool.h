@@ -3,11 +3,30 @@
 
 #include <unordered_map>
 #include <tuple>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <memory_resource>
 
 #include "cluster.h"
+#include "sparse_set.h"
+#include "entity.h"
 #include "signature.h"
 #include "entity_group.h"
+#include "partition.h"
+#include "thread_pool.h"
+#include "query.h"
 #include "view.h"
+#include "policy.h"
+#include "memory.h"
+#include "observer.h"
+#include "resource.h"
+#include "hierarchy.h"
+#include "index.h"
+#include "shared.h"
 #include "typedefs.h"
 
 #include "Byte/Container/sparse_vector.h"
@@ -18,23 +37,84 @@ namespace Byte::ECS
 	class Pool
 	{
 	private:
-		struct EntityData
-		{
-			Cluster* cluster{ nullptr };
-			size_t index;
-		};
-
-		using EntityContainer = sparse_vector<EntityData>;
+		using EntityData = EntityLocation;
+		using EntityContainer = EntityLocationContainer;
+		using VersionContainer = std::pmr::vector<EntityVersion>;
+		using PolicyMap = std::unordered_map<ComponentID, GrowthPolicy>;
+		using SparseContainer = std::pmr::unordered_map<ComponentID, SparseSet>;
 
+		std::pmr::memory_resource* _resource;
 		ClusterContainer clusters;
+		SparseContainer sparseSets;
 		EntityContainer entityContainer;
+		VersionContainer versions;
+		QueryRegistry queries;
+		ObserverRegistry observers;
+		ResourceRegistry resources;
+		SharedRegistry sharedValues;
+		Hierarchy hierarchy;
+		IndexRegistry indexes;
+		ClusterStorage storage{ ClusterStorage::CONTIGUOUS };
+		Tick _tick{ 1 };
+		GrowthPolicy defaultPolicy;
+		PolicyMap componentPolicies;
+
+	public:
+		inline static constexpr size_t DEFAULT_GRAIN{ 1024 };
 
 	public:
-		Pool() = default;
+		Pool(ClusterStorage storage = ClusterStorage::CONTIGUOUS,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			:_resource{ resource }, clusters{ resource }, sparseSets{ resource }, entityContainer{ _BITSET_SIZE, resource },
+			versions{ resource }, queries{ resource }, resources{ resource }, sharedValues{ resource }, hierarchy{ resource }, indexes{ resource }, storage{ storage }
+		{
+		}
+
+		Pool(std::pmr::memory_resource* resource)
+			:Pool{ ClusterStorage::CONTIGUOUS, resource }
+		{
+		}
+
+		std::pmr::memory_resource* resource() const
+		{
+			return _resource;
+		}
+
+		Tick tick() const
+		{
+			return _tick;
+		}
+
+		Tick advance()
+		{
+			return ++_tick;
+		}
+
+		template<typename Type, typename Callable>
+		void onAdd(Callable&& callable)
+		{
+			observers.onAdd<Type>(std::forward<Callable>(callable));
+		}
+
+		template<typename Type, typename Callable>
+		void onRemove(Callable&& callable)
+		{
+			observers.onRemove<Type>(std::forward<Callable>(callable));
+		}
+
+		void flush()
+		{
+			observers.flush();
+		}
 
 		EntityID create()
 		{
-			return entityContainer.push(EntityData{});
+			size_t index{ entityContainer.push(EntityData{}) };
+			if (index >= versions.size())
+			{
+				versions.resize(index + 1);
+			}
+			return EntityHandle::make(index, versions[index]);
 		}
 
 		template<typename Type, typename... Types>
@@ -45,183 +125,1337 @@ namespace Byte::ECS
 			return out;
 		}
 
+		template<typename Type, typename... Types>
+		std::vector<EntityID> createMany(size_t count)
+		{
+			return createMany<Type, Types...>(count, [](EntityID, Type&, Types&...) {});
+		}
+
+		template<typename Type, typename... Types, typename Initializer>
+		std::vector<EntityID> createMany(size_t count, const Initializer& initializer)
+		{
+			static_assert((std::is_default_constructible_v<Type> && ... && std::is_default_constructible_v<Types>), "Components created in bulk must be default constructible");
+			static_assert((!ComponentRegistry<Type>::sparse && ... && !ComponentRegistry<Types>::sparse), "Sparse components cannot be created in bulk");
+			static_assert((!ComponentRegistry<Type>::shared && ... && !ComponentRegistry<Types>::shared), "Shared components cannot be created in bulk");
+
+			Cluster& cluster{ _reserve<Type, Types...>(count) };
+			size_t first{ cluster.size() };
+
+			std::vector<EntityID> out;
+			out.reserve(count);
+
+			entityContainer.emplace_n(count, [&](size_t index)
+				{
+					if (index >= versions.size())
+					{
+						versions.resize(index + 1);
+					}
+
+					EntityID id{ EntityHandle::make(index, versions[index]) };
+					cluster.pushEntity(id);
+					out.push_back(id);
+
+					return EntityData{ &cluster, cluster.size() - 1 };
+				});
+
+			cluster.resizeColumns(cluster.size());
+			cluster.markAdded(first, cluster.size(), _tick);
+			observers.added(std::span<const EntityID>{ out }, SignatureBuilder<Type, Types...>{});
+
+			ClusterCache<Type, Types...> cache{ cluster };
+			for (size_t index{ first }; index < cluster.size(); ++index)
+			{
+				std::apply(initializer, cache.groupWithID(index));
+			}
+
+			if (!indexes.empty())
+			{
+				for (auto id : out)
+				{
+					_reindex<Type, Types...>(id);
+				}
+			}
+
+			return out;
+		}
+
+		template<typename Type, typename... Types>
+		void reserve(size_t count)
+		{
+			_reserve<Type, Types...>(count);
+		}
+
+		void reserve(size_t count)
+		{
+			entityContainer.reserve(entityContainer.size() + count);
+			versions.reserve(entityContainer.capacity());
+		}
+
+		void compact()
+		{
+			for (auto& pair : clusters)
+			{
+				pair.second.compact();
+			}
+
+			for (auto& pair : sparseSets)
+			{
+				pair.second.compact();
+			}
+
+			if (defaultPolicy.shrinks(entityContainer.size(), entityContainer.capacity()))
+			{
+				entityContainer.shrink_to_fit();
+			}
+		}
+
+		const GrowthPolicy& policy() const
+		{
+			return defaultPolicy;
+		}
+
+		void policy(const GrowthPolicy& policy)
+		{
+			defaultPolicy = policy;
+			for (auto& pair : clusters)
+			{
+				_configure(pair.second);
+			}
+		}
+
+		template<typename Type>
+		void policy(const GrowthPolicy& policy)
+		{
+			ComponentID id{ ComponentRegistry<Type>::id };
+			componentPolicies[id] = policy;
+
+			for (auto& pair : clusters)
+			{
+				pair.second.policy(id, policy);
+			}
+		}
+
 		EntityID copy(EntityID source)
 		{
+			EntityData data{ _checked(source) };
 			EntityID out{ create() };
-			Cluster& cluster{ *entityContainer[source].cluster };
-			entityContainer[out].index = ClusterBridge::copy(cluster, cluster, out, entityContainer[source].index);
-			entityContainer[out].cluster = &cluster;
+
+			if (data.cluster)
+			{
+				Cluster& cluster{ *data.cluster };
+				size_t index{ ClusterBridge::copy(cluster, cluster, out, data.index) };
+				cluster.markAdded(index, index + 1, _tick);
+				observers.added(out, cluster.signature());
+
+				_entity(out).cluster = &cluster;
+				_entity(out).index = index;
+			}
+
+			for (auto& pair : sparseSets)
+			{
+				if (pair.second.contains(source))
+				{
+					pair.second.copy(source, out, _tick);
+					observers.added(out, pair.first);
+				}
+			}
+
+			indexes.each([&](ComponentID component, ComponentIndex&)
+				{
+					_reindex(out, component);
+				});
 
 			return out;
 		}
 
 		void destroy(EntityID id)
 		{
-			Cluster* cluster{ entityContainer[id].cluster };
+			Cluster* cluster{ _checked(id).cluster };
 			if (cluster)
 			{
+				observers.removed(id, cluster->signature());
 				_detach(*cluster, id);
 			}
-			entityContainer.erase(id);
 
-			if (entityContainer.size() / static_cast<double>(entityContainer.capacity()) < 0.25)
+			_eraseSparse(id);
+			hierarchy.erase(id);
+			indexes.erase(id);
+
+			size_t index{ EntityHandle::index(id) };
+			versions[index] = EntityHandle::next(versions[index]);
+			entityContainer.erase(index);
+		}
+
+		template<typename Type, typename... Types>
+		size_t destroyAll()
+		{
+			if constexpr ((ComponentRegistry<Type>::sparse || ... || ComponentRegistry<Types>::sparse))
 			{
-				entityContainer.shrink_to_fit();
+				std::vector<EntityID> matched;
+				join<const Type, const Types...>().each([&](EntityID id, const auto&...)
+					{
+						matched.push_back(id);
+					});
+
+				for (auto id : matched)
+				{
+					destroy(id);
+				}
+				return matched.size();
+			}
+			else
+			{
+				return destroyAll(SignatureBuilder<Type, Types...>{});
+			}
+		}
+
+		size_t destroyAll(const Signature& include, const Signature& exclude = Signature{})
+		{
+			size_t out{ 0 };
+
+			for (auto cluster : query(include, exclude).clusters())
+			{
+				for (size_t chunk{}; chunk < cluster->chunkCount(); ++chunk)
+				{
+					observers.removed(cluster->entityChunk(chunk), cluster->signature());
+				}
+
+				for (auto id : cluster->entities())
+				{
+					_eraseSparse(id);
+					hierarchy.erase(id);
+					indexes.erase(id);
+
+					size_t index{ EntityHandle::index(id) };
+					versions[index] = EntityHandle::next(versions[index]);
+					entityContainer.erase(index);
+				}
+
+				out += cluster->size();
+				cluster->clear();
 			}
+
+			return out;
 		}
 
 		template<typename Type, typename... Types>
 		void attach(EntityID id, Type&& component, Types&&... components)
 		{
-			Signature signature{ SignatureBuilder<Type,Types...>() };
+			if constexpr ((_separate<Type>() || ... || _separate<Types>()))
+			{
+				_checked(id);
 
-			Cluster* oldCluster{ entityContainer[id].cluster };
-			Cluster* newCluster{ nullptr };
-			
-			auto result{ clusters.find(signature) };
-			if (result != clusters.end())
+				std::apply([&](auto&&... table)
+					{
+						if constexpr (sizeof...(table) > 0)
+						{
+							_attachTable(id, std::move(table)...);
+						}
+					}, std::tuple_cat(_table(component), _table(components)...));
+
+				_attachSeparate(id, std::move(component));
+				(_attachSeparate(id, std::move(components)), ...);
+			}
+			else
+			{
+				_attachTable(id, std::move(component), std::move(components)...);
+			}
+
+			_reindex<Type, Types...>(id);
+		}
+
+		template<typename Type>
+		void detach(EntityID id)
+		{
+			if constexpr (ComponentRegistry<Type>::sparse)
 			{
-				newCluster = &result->second;
+				_checked(id);
+
+				auto result{ sparseSets.find(ComponentRegistry<Type>::id) };
+				if (result != sparseSets.end() && result->second.erase(id))
+				{
+					observers.removed(id, ComponentRegistry<Type>::id);
+				}
 			}
 			else
 			{
-				if (oldCluster)
+				_detachTable<Type>(id);
+			}
+
+			indexes.erase(id, ComponentRegistry<Type>::id);
+		}
+
+		void place(EntityID id, const Signature& signature, std::span<const ComponentPayload> payloads)
+		{
+			Cluster* oldCluster{ _checked(id).cluster };
+			Signature oldSignature{ oldCluster ? oldCluster->signature() : Signature{} };
+
+			if (oldCluster && oldSignature == signature)
+			{
+				for (auto& payload : payloads)
 				{
-					clusters[signature] = ClusterBuilder::build<Type,Types...>(*oldCluster);
+					if (signature.test(payload.id))
+					{
+						oldCluster->replace(payload.id, _entity(id).index, payload.data, _tick);
+						_reindex(id, payload.id);
+					}
 				}
-				else
+				return;
+			}
+
+			Signature removed{ oldSignature - signature };
+			if (removed.any())
+			{
+				observers.removed(id, removed);
+				removed.each([&](ComponentID component)
+					{
+						indexes.erase(id, component);
+					});
+			}
+
+			if (signature.none())
+			{
+				if (oldCluster)
 				{
-					clusters[signature] = ClusterBuilder::build<Type,Types...>();
+					_detach(*oldCluster, id);
 				}
-				newCluster = &clusters[signature];
+				return;
+			}
+
+			Cluster* newCluster{ _find(ClusterKey{ signature, oldCluster ? oldCluster->shared() : SharedValues{} }) };
+			if (!newCluster)
+			{
+				newCluster = &_insert(ClusterBuilder::build(signature, payloads, oldCluster, storage, _resource));
 			}
 
 			if (oldCluster)
 			{
-				ClusterBridge::carry(*oldCluster, *newCluster, id, entityContainer[id].index );
-				_detach(*oldCluster, id);
+				_move(*oldCluster, *newCluster, ClusterBridge::map(*oldCluster, *newCluster), id);
 			}
 			else
 			{
 				newCluster->pushEntity(id);
+				_entity(id).cluster = newCluster;
+				_entity(id).index = newCluster->size() - 1;
 			}
 
-			_attach<Type,Types...>(*newCluster, std::move(component), std::move(components)...);
+			size_t index{ _entity(id).index };
+			for (auto& payload : payloads)
+			{
+				if (!signature.test(payload.id))
+				{
+					continue;
+				}
+
+				if (oldSignature.test(payload.id))
+				{
+					newCluster->replace(payload.id, index, payload.data, _tick);
+				}
+				else
+				{
+					newCluster->push(payload.id, payload.data, _tick);
+				}
+				_reindex(id, payload.id);
+			}
 
-			entityContainer[id].cluster = newCluster;
-			entityContainer[id].index = newCluster->size() - 1;
+			Signature added{ signature - oldSignature };
+			if (added.any())
+			{
+				observers.added(id, added);
+			}
 		}
 
 		template<typename Type>
-		void detach(EntityID id)
+		Type& get(EntityID id)
 		{
-			Cluster* oldCluster{ entityContainer[id].cluster };
-
-			Signature signature{ oldCluster->signature() };
-			signature.set(ComponentRegistry<Type>::id, false);
-
-			if (signature.any())
+			if constexpr (ComponentRegistry<Type>::sparse)
+			{
+				auto [set, index] { _sparseComponent<Type>(id) };
+				if constexpr (std::is_const_v<Type>)
+				{
+					return set->template get<Type>(index);
+				}
+				else
+				{
+					return set->template get<Type>(index, _tick);
+				}
+			}
+			else if constexpr (ComponentRegistry<Type>::shared)
 			{
-				auto result{ clusters.find(signature) };
-				Cluster* newCluster{ &clusters[signature] };
+				static_assert(std::is_const_v<Type>, "Shared components are read-only, access them as const");
 
-				if (result == clusters.end())
+				EntityData& data{ _component<Type>(id) };
+				return *static_cast<Type*>(data.cluster->shared(ComponentRegistry<Type>::id));
+			}
+			else
+			{
+				EntityData& data{ _component<Type>(id) };
+				if constexpr (std::is_const_v<Type>)
 				{
-					clusters[signature] = ClusterBuilder::buildWithout<Type>(*oldCluster);
-					newCluster = &clusters[signature];
+					return data.cluster->get<Type>(data.index);
 				}
 				else
 				{
-					newCluster = &result->second;
+					return data.cluster->get<Type>(data.index, _tick);
 				}
-				ClusterBridge::carry(*oldCluster, *newCluster, id, entityContainer[id].index);
 			}
-			_detach(*oldCluster, id);
 		}
 
 		template<typename Type>
-		Type& get(EntityID id)
+		const Type& get(EntityID id) const
 		{
-			return entityContainer[id].cluster->get<Type>(entityContainer[id].index);
+			return const_cast<Pool&>(*this).get<const Type>(id);
 		}
 
-		template<typename Type>
-		const Type& get(EntityID id) const
+		Signature signature(EntityID id) const
 		{
-			return entityContainer[id].cluster->get<Type>(entityContainer[id].index);
+			const EntityData& data{ _checked(id) };
+			if (data.cluster)
+			{
+				return data.cluster->signature();
+			}
+			return Signature{};
 		}
 
 		template<typename Type>
 		bool has(EntityID id) const
 		{
-			return entityContainer[id].cluster->signature().test(ComponentRegistry<Type>::id);
+			const EntityData& data{ _checked(id) };
+			if constexpr (ComponentRegistry<Type>::sparse)
+			{
+				auto result{ sparseSets.find(ComponentRegistry<Type>::id) };
+				return result != sparseSets.end() && result->second.contains(id);
+			}
+			else
+			{
+				return data.cluster && data.cluster->signature().test(ComponentRegistry<Type>::id);
+			}
 		}
 
-		void clear()
+		template<typename Type, typename... Args>
+		Type& emplaceResource(Args&&... args)
 		{
-			clusters.clear();
-			entityContainer.clear();
+			return resources.emplace<Type>(std::forward<Args>(args)...);
 		}
 
-		size_t size() const
+		template<typename Type>
+		Type& getResource()
 		{
-			return entityContainer.size();
+			return resources.get<Type>();
 		}
 
-		EntityGroup entities()
+		template<typename Type>
+		const Type& getResource() const
 		{
-			return EntityGroup{ Query::include(clusters, Signature{}) };
+			return resources.get<Type>();
 		}
 
-		template<typename Type, typename... Types>
-		EntityGroup entities()
+		template<typename Type>
+		Type* findResource()
 		{
-			return EntityGroup{ Query::include(clusters, SignatureBuilder<Type, Types...>{}) };
+			return resources.find<Type>();
 		}
 
-		template<typename Type, typename... Types>
-		View<Type, Types...> components()
+		template<typename Type>
+		bool hasResource() const
 		{
-			return View<Type, Types...>(Query::include(clusters, SignatureBuilder<Type, Types...>{}));
+			return resources.contains<Type>();
 		}
 
-		template<typename Type, typename... Types>
-		IDView<Type, Types...> componentsWithID()
+		template<typename Type>
+		bool removeResource()
 		{
-			return IDView<Type, Types...>(Query::include(clusters, SignatureBuilder<Type, Types...>{}));
+			return resources.erase<Type>();
 		}
 
-		template<typename Type, typename... Types, typename Callable>
-		void apply(const Callable& callable)
+		template<typename Type, IndexKind Kind = IndexKind::HASH, typename Extractor>
+		void createIndex(const Extractor& extractor)
 		{
-			View<Type, Types...> view{ components<Type,Types...>() };
-			for (auto tuple : view)
+			static_assert(!ComponentRegistry<Type>::tag, "Tag components carry no value to index");
+
+			ComponentIndex& out{ indexes.emplace<Type, Kind>(extractor) };
+
+			if constexpr (ComponentRegistry<Type>::sparse)
+			{
+				if (SparseSet* set{ _findSparse<Type>() })
+				{
+					for (size_t index{}; index < set->size(); ++index)
+					{
+						out.insert(set->entities()[index], set->data().at(index));
+					}
+				}
+			}
+			else
 			{
-				std::apply(callable,tuple);
+				for (auto cluster : query<Type>().clusters())
+				{
+					for (size_t index{}; index < cluster->size(); ++index)
+					{
+						out.insert(cluster->entities()[index], _address(cluster->entities()[index], ComponentRegistry<Type>::id));
+					}
+				}
 			}
 		}
 
-		bool contains(EntityID id) const
+		template<typename Type>
+		bool removeIndex()
 		{
-			return entityContainer.test(id);
+			return indexes.erase<Type>();
 		}
 
-	private:
-		void _detach(Cluster& cluster, EntityID id)
+		template<typename Type, typename Key>
+		std::span<const EntityID> find(const Key& key) const
+		{
+			return indexes.lookup<Type>(key);
+		}
+
+		template<typename Type, typename Key>
+		std::vector<EntityID> findRange(const Key& low, const Key& high) const
+		{
+			return indexes.lookup<Type>(low, high);
+		}
+
+		template<typename Type, typename Callable>
+		void write(EntityID id, const Callable& callable)
+		{
+			static_assert(!std::is_const_v<Type>, "Writes need mutable access to the component");
+
+			callable(get<Type>(id));
+			_reindex(id, ComponentRegistry<Type>::id);
+		}
+
+		void parent(EntityID child, EntityID parent)
 		{
-			size_t newIndex{ entityContainer[id].index };
-			EntityID changed{ cluster.remove(newIndex) };
-			if (!cluster.empty())
+			_checked(child);
+
+			if (parent == nullent)
+			{
+				hierarchy.unlink(child);
+			}
+			else
 			{
-				entityContainer[changed].index = newIndex;
-				entityContainer[id].cluster = nullptr;
+				_checked(parent);
+				hierarchy.link(child, parent);
+			}
+		}
+
+		EntityID parent(EntityID id) const
+		{
+			_checked(id);
+			return hierarchy.parent(id);
+		}
+
+		EntityID firstChild(EntityID id) const
+		{
+			_checked(id);
+			return hierarchy.firstChild(id);
+		}
+
+		EntityID nextSibling(EntityID id) const
+		{
+			_checked(id);
+			return hierarchy.nextSibling(id);
+		}
+
+		template<typename Callable>
+		void traverse(const Callable& callable)
+		{
+			for (auto id : hierarchy.order())
+			{
+				callable(id, hierarchy.parent(id));
+			}
+		}
+
+		template<typename Type, typename Callable>
+		void propagate(const Callable& callable)
+		{
+			static_assert(!std::is_const_v<Type>, "Propagation writes to the child component");
+			static_assert(!_separate<Type>() && !ComponentRegistry<Type>::tag, "Only table components propagate through cluster rows");
+
+			struct Cursor
+			{
+				ClusterCache<Type> cache;
+				std::vector<size_t> positions;
+				size_t row;
+				size_t chunk;
+			};
+
+			const auto& order{ hierarchy.order() };
+			const auto& levels{ hierarchy.levels() };
+			const auto& parents{ hierarchy.parents() };
+
+			if (levels.size() < 3)
+			{
+				return;
+			}
+
+			// Rows are kept in breadth-first order so every depth is a contiguous run per cluster.
+			std::vector<Cursor> cursors;
+			for (auto cluster : query<Type>().clusters())
+			{
+				std::vector<size_t> positions;
+				positions.reserve(cluster->size());
+				for (auto id : cluster->entities())
+				{
+					positions.push_back(hierarchy.position(id));
+				}
+
+				if (std::find_if(positions.begin(), positions.end(), [](size_t position) { return position != Hierarchy::NONE; }) == positions.end())
+				{
+					continue;
+				}
+
+				if (!std::is_sorted(positions.begin(), positions.end()))
+				{
+					_sort(*cluster, [&](size_t left, size_t right)
+						{
+							return positions[left] < positions[right];
+						}, SortMode::FULL);
+					std::stable_sort(positions.begin(), positions.end());
+				}
+
+				cursors.push_back(Cursor{ ClusterCache<Type>{ *cluster }, std::move(positions), 0, 0 });
+			}
+
+			size_t parent{ Hierarchy::NONE };
+			const Type* source{ nullptr };
+
+			for (size_t depth{ 1 }; depth + 1 < levels.size(); ++depth)
+			{
+				for (auto& cursor : cursors)
+				{
+					auto& [cache, positions, row, chunk] { cursor };
+					while (row < positions.size() && positions[row] < levels[depth])
+					{
+						++row;
+					}
+
+					for (; chunk < cache.chunkCount(); ++chunk)
+					{
+						size_t base{ cache.chunkBase(chunk) };
+						size_t end{ base + cache.chunkSize(chunk) };
+						if (row >= end)
+						{
+							continue;
+						}
+
+						Type* data{ std::get<0>(cache.chunk(chunk)) };
+
+						for (; row < end && positions[row] < levels[depth + 1]; ++row)
+						{
+							if (parents[positions[row]] != parent)
+							{
+								parent = parents[positions[row]];
+								source = static_cast<const Type*>(_address(order[parent], ComponentRegistry<Type>::id));
+							}
+
+							if (source)
+							{
+								callable(*source, data[row - base]);
+								cache.eachMutable([&](Column& column) { column.markChanged(row, _tick); });
+							}
+						}
+
+						if (row < end)
+						{
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		template<typename Type, typename Compare>
+		void sort(const Compare& compare, SortMode mode = SortMode::FULL)
+		{
+			static_assert(!_separate<Type>() && !ComponentRegistry<Type>::tag, "Only table components order cluster rows");
+
+			for (auto cluster : query<Type>().clusters())
+			{
+				_sort(*cluster, [&](size_t left, size_t right)
+					{
+						return compare(cluster->template get<const Type>(left), cluster->template get<const Type>(right));
+					}, mode);
+			}
+		}
+
+		template<typename Type, typename Extractor>
+		void sortBy(const Extractor& extractor, SortMode mode = SortMode::FULL)
+		{
+			static_assert(!_separate<Type>() && !ComponentRegistry<Type>::tag, "Only table components order cluster rows");
+
+			using Key = std::remove_cvref_t<std::invoke_result_t<const Extractor&, const Type&>>;
+
+			std::vector<Key> keys;
+			for (auto cluster : query<Type>().clusters())
+			{
+				keys.clear();
+				keys.reserve(cluster->size());
+				for (size_t index{}; index < cluster->size(); ++index)
+				{
+					keys.push_back(extractor(cluster->template get<const Type>(index)));
+				}
+
+				_sort(*cluster, [&](size_t left, size_t right)
+					{
+						return keys[left] < keys[right];
+					}, mode);
+			}
+		}
+
+		void clear()
+		{
+			for (auto& pair : clusters)
+			{
+				for (size_t chunk{}; chunk < pair.second.chunkCount(); ++chunk)
+				{
+					observers.removed(pair.second.entityChunk(chunk), pair.second.signature());
+				}
+			}
+
+			for (auto& pair : sparseSets)
+			{
+				Signature signature;
+				signature.set(pair.first);
+				observers.removed(std::span<const EntityID>{ pair.second.entities() }, signature);
+			}
+
+			clusters.clear();
+			sparseSets.clear();
+			sharedValues.clear();
+			hierarchy.clear();
+			indexes.clear();
+			entityContainer.clear();
+
+			for (auto& version : versions)
+			{
+				version = EntityHandle::next(version);
+			}
+
+			queries.clear();
+		}
+
+		size_t size() const
+		{
+			return entityContainer.size();
+		}
+
+		EntityGroup entities()
+		{
+			return EntityGroup{ query(Signature{}).clusters() };
+		}
+
+		template<typename Type, typename... Types>
+		EntityGroup entities()
+		{
+			static_assert((!ComponentRegistry<Type>::sparse && ... && !ComponentRegistry<Types>::sparse), "Sparse components are not stored in clusters, iterate them with Pool::join");
+			return EntityGroup{ query<Type, Types...>().clusters() };
+		}
+
+		template<typename Type, typename... Types>
+		View<Type, Types...> components()
+		{
+			return View<Type, Types...>(query<Type, Types...>().clusters(), _tick);
+		}
+
+		template<typename Type, typename... Types>
+		IDView<Type, Types...> componentsWithID()
+		{
+			return IDView<Type, Types...>(query<Type, Types...>().clusters(), _tick);
+		}
+
+		template<typename Type, typename... Types>
+		JoinView<Type, Types...> join()
+		{
+			return JoinView<Type, Types...>{ entityContainer, { _findSparse<Type>(), _findSparse<Types>()... }, _tick };
+		}
+
+		QueryCache& query(const Signature& include, const Signature& exclude = Signature{})
+		{
+			return queries.get(QueryKey{ include, exclude }, clusters);
+		}
+
+		template<typename Type, typename... Types>
+		QueryCache& query()
+		{
+			static_assert((!ComponentRegistry<Type>::sparse && ... && !ComponentRegistry<Types>::sparse), "Sparse components are not stored in clusters, iterate them with Pool::join");
+			return query(SignatureBuilder<Type, Types...>{});
+		}
+
+		template<typename Type, typename... Types, typename Callable>
+		void apply(const Callable& callable)
+		{
+			_eachSpan<Type, Types...>(query<Type, Types...>().clusters(), _tick, TickFilters{}, [&](ClusterCache<Type, Types...>& cache, size_t chunk, size_t offset, size_t size)
+				{
+					std::apply([&](Type* first, Types*... others)
+						{
+							for (size_t row{ offset }; row < offset + size; ++row)
+							{
+								callable(_element(first, row), _element(others, row)...);
+							}
+						}, cache.chunk(chunk));
+				});
+		}
+
+		template<typename Type, typename... Types, typename Callable, typename Executor>
+		void parallelApply(const Callable& callable, size_t grain, Executor& executor)
+		{
+			const ClusterGroup& group{ query<Type, Types...>().clusters() };
+			ClusterPartition partition{ group, grain };
+
+			for (auto cluster : group)
+			{
+				ClusterCache<Type, Types...>{ *cluster }.eachMutable([&](Column& column) { column.markChanged(0, cluster->size(), _tick); });
+			}
+
+			executor.execute(partition.size(), [&](size_t task)
+				{
+					partition.each(task, [&](const ClusterRange& range)
+						{
+							ClusterCache<Type, Types...> cache{ *range.cluster };
+							size_t capacity{ range.cluster->chunkCapacity() };
+
+							for (size_t index{ range.begin }; index < range.end;)
+							{
+								size_t chunk{ index / capacity };
+								size_t offset{ index % capacity };
+								size_t count{ std::min(range.end - index, cache.chunkSize(chunk) - offset) };
+
+								std::apply([&](Type* first, Types*... others)
+									{
+										for (size_t row{ offset }; row < offset + count; ++row)
+										{
+											callable(_element(first, row), _element(others, row)...);
+										}
+									}, cache.chunk(chunk));
+
+								index += count;
+							}
+						});
+				});
+		}
+
+		template<typename Type, typename... Types, typename Callable>
+		void parallelApply(const Callable& callable, size_t grain = DEFAULT_GRAIN)
+		{
+			parallelApply<Type, Types...>(callable, grain, ThreadPool::global());
+		}
+
+		bool contains(EntityID id) const
+		{
+			size_t index{ EntityHandle::index(id) };
+			return index < versions.size() && versions[index] == EntityHandle::version(id);
+		}
+
+	private:
+		Cluster& _insert(Cluster&& cluster)
+		{
+			ClusterKey key{ cluster.key() };
+			Cluster& out{ clusters.emplace(std::move(key), std::move(cluster)).first->second };
+			_configure(out);
+			queries.push(out);
+			return out;
+		}
+
+		void _configure(Cluster& cluster)
+		{
+			cluster.policy(defaultPolicy);
+			for (auto& pair : componentPolicies)
+			{
+				cluster.policy(pair.first, pair.second);
+			}
+		}
+
+		template<typename Type, typename... Types>
+		Cluster& _reserve(size_t count)
+		{
+			Signature signature{ SignatureBuilder<Type, Types...>{} };
+
+			Cluster* cluster{ _find(ClusterKey{ signature, {} }) };
+			if (!cluster)
+			{
+				cluster = &_insert(ClusterBuilder::build<Type, Types...>(storage, _resource));
+			}
+
+			cluster->reserve(cluster->size() + count);
+			entityContainer.reserve(entityContainer.size() + count);
+			versions.reserve(entityContainer.capacity());
+
+			return *cluster;
+		}
+
+		Cluster* _find(const ClusterKey& key)
+		{
+			auto result{ clusters.find(key) };
+			if (result != clusters.end())
+			{
+				return &result->second;
+			}
+			return nullptr;
+		}
+
+		template<typename Type>
+		ClusterEdge& _addEdge(Cluster& cluster)
+		{
+			ComponentID id{ ComponentRegistry<Type>::id };
+			ClusterEdge& edge{ cluster.addEdge(id) };
+
+			if (!edge.destination)
+			{
+				ClusterKey key{ cluster.key() };
+				key.signature.set(id);
+
+				Cluster* destination{ _find(key) };
+				if (!destination)
+				{
+					destination = &_insert(ClusterBuilder::build<Type>(cluster));
+				}
+
+				_link(cluster, *destination, id);
+			}
+
+			return edge;
+		}
+
+		template<typename Type>
+		ClusterEdge* _removeEdge(Cluster& cluster)
+		{
+			ComponentID id{ ComponentRegistry<Type>::id };
+			ClusterEdge& edge{ cluster.removeEdge(id) };
+
+			if (!edge.destination)
+			{
+				ClusterKey key{ cluster.key() };
+				key.signature.set(id, false);
+
+				if (key.signature.none())
+				{
+					return nullptr;
+				}
+
+				std::erase_if(key.shared, [id](const SharedValue& value)
+					{
+						return value.id == id;
+					});
+
+				Cluster* destination{ _find(key) };
+				if (!destination)
+				{
+					destination = &_insert(ClusterBuilder::buildWithout<Type>(cluster));
+				}
+
+				_link(*destination, cluster, id);
+			}
+
+			return &edge;
+		}
+
+		void _link(Cluster& lower, Cluster& upper, ComponentID id)
+		{
+			ClusterEdge& add{ lower.addEdge(id) };
+			add.destination = &upper;
+			add.columns = ClusterBridge::map(lower, upper);
+
+			ClusterEdge& remove{ upper.removeEdge(id) };
+			remove.destination = &lower;
+			remove.columns = ClusterBridge::map(upper, lower);
+		}
+
+		void _move(Cluster& source, Cluster& destination, const ColumnMap& columns, EntityID id)
+		{
+			size_t index{ ClusterBridge::carry(destination, columns, id, _entity(id).index) };
+			_detach(source, id);
+
+			_entity(id).cluster = &destination;
+			_entity(id).index = index;
+		}
+
+		void _detach(Cluster& cluster, EntityID id)
+		{
+			size_t index{ _entity(id).index };
+			EntityID changed{ cluster.remove(index) };
+			if (changed != id)
+			{
+				_entity(changed).index = index;
+			}
+			_entity(id).cluster = nullptr;
+		}
+
+		EntityData& _entity(EntityID id)
+		{
+			return entityContainer[EntityHandle::index(id)];
+		}
+
+		const EntityData& _entity(EntityID id) const
+		{
+			return entityContainer[EntityHandle::index(id)];
+		}
+
+		EntityData& _checked(EntityID id)
+		{
+			if (!contains(id))
+			{
+				throw std::out_of_range{ "Invalid EntityID" };
+			}
+			return _entity(id);
+		}
+
+		const EntityData& _checked(EntityID id) const
+		{
+			if (!contains(id))
+			{
+				throw std::out_of_range{ "Invalid EntityID" };
+			}
+			return _entity(id);
+		}
+
+		template<typename Type>
+		EntityData& _component(EntityID id)
+		{
+			EntityData& data{ _checked(id) };
+			if (!data.cluster || !data.cluster->signature().test(ComponentRegistry<Type>::id))
+			{
+				throw std::out_of_range{ "Entity does not have the component" };
+			}
+			return data;
+		}
+
+		template<typename Type, typename... Types>
+		void _attachTable(EntityID id, Type&& component, Types&&... components)
+		{
+			Cluster* oldCluster{ _checked(id).cluster };
+
+			if constexpr (sizeof...(Types) == 0)
+			{
+				if (oldCluster && !oldCluster->signature().test(ComponentRegistry<Type>::id))
+				{
+					ClusterEdge& edge{ _addEdge<Type>(*oldCluster) };
+					_move(*oldCluster, *edge.destination, edge.columns, id);
+					if constexpr (!ComponentRegistry<Type>::tag)
+					{
+						edge.destination->push<Type>(std::move(component));
+						edge.destination->markAdded(ComponentRegistry<Type>::id, edge.destination->size() - 1, _tick);
+					}
+					observers.added(id, ComponentRegistry<Type>::id);
+					return;
+				}
+			}
+
+			Signature signature{ SignatureBuilder<Type,Types...>() };
+			if (oldCluster)
+			{
+				signature |= oldCluster->signature();
+			}
+
+			if (oldCluster && oldCluster->signature() == signature)
+			{
+				_assign<Type, Types...>(*oldCluster, _entity(id).index, std::move(component), std::move(components)...);
+				return;
+			}
+
+			Cluster* newCluster{ _find(ClusterKey{ signature, oldCluster ? oldCluster->shared() : SharedValues{} }) };
+			if (!newCluster)
+			{
+				if (oldCluster)
+				{
+					newCluster = &_insert(ClusterBuilder::build<Type,Types...>(*oldCluster));
+				}
+				else
+				{
+					newCluster = &_insert(ClusterBuilder::build<Type,Types...>(storage, _resource));
+				}
+			}
+
+			if (oldCluster)
+			{
+				Signature oldSignature{ oldCluster->signature() };
+				_move(*oldCluster, *newCluster, ClusterBridge::map(*oldCluster, *newCluster), id);
+				_attach<Type, Types...>(*newCluster, oldSignature, std::move(component), std::move(components)...);
+			}
+			else
+			{
+				newCluster->pushEntity(id);
+				_attach<Type, Types...>(*newCluster, Signature{}, std::move(component), std::move(components)...);
+
+				_entity(id).cluster = newCluster;
+				_entity(id).index = newCluster->size() - 1;
+			}
+		}
+
+		template<typename Type>
+		void _detachTable(EntityID id)
+		{
+			Cluster* oldCluster{ _checked(id).cluster };
+
+			if (!oldCluster || !oldCluster->signature().test(ComponentRegistry<Type>::id))
+			{
+				return;
+			}
+
+			observers.removed(id, ComponentRegistry<Type>::id);
+
+			ClusterEdge* edge{ _removeEdge<Type>(*oldCluster) };
+			if (edge)
+			{
+				_move(*oldCluster, *edge->destination, edge->columns, id);
+			}
+			else
+			{
+				_detach(*oldCluster, id);
+			}
+		}
+
+		template<typename Type>
+		static constexpr bool _separate()
+		{
+			return ComponentRegistry<Type>::sparse || ComponentRegistry<Type>::shared;
+		}
+
+		template<typename Type>
+		void _attachSeparate(EntityID id, Type&& component)
+		{
+			if constexpr (ComponentRegistry<Type>::sparse)
+			{
+				auto result{ sparseSets.try_emplace(ComponentRegistry<Type>::id, ComponentRegistry<Type>::info, _resource) };
+				if (result.first->second.emplace(id, std::move(component), _tick))
+				{
+					observers.added(id, ComponentRegistry<Type>::id);
+				}
+			}
+			else if constexpr (ComponentRegistry<Type>::shared)
+			{
+				_attachShared(id, std::move(component));
+			}
+		}
+
+		template<typename Type>
+		void _attachShared(EntityID id, Type&& component)
+		{
+			ComponentID componentID{ ComponentRegistry<Type>::id };
+			SharedValue value{ sharedValues.intern(std::move(component)) };
+			Cluster* oldCluster{ _checked(id).cluster };
+
+			ClusterKey key{ oldCluster ? oldCluster->key() : ClusterKey{} };
+			bool exists{ key.signature.test(componentID) };
+
+			auto position{ std::find_if(key.shared.begin(), key.shared.end(), [componentID](const SharedValue& current)
+				{
+					return current.id >= componentID;
+				}) };
+
+			if (exists)
+			{
+				if (*position == value)
+				{
+					return;
+				}
+				*position = value;
+			}
+			else
+			{
+				key.signature.set(componentID);
+				key.shared.insert(position, value);
+			}
+
+			Cluster* newCluster{ _find(key) };
+			if (!newCluster)
+			{
+				Cluster cluster{ oldCluster ? ClusterBuilder::build<Type>(*oldCluster) : ClusterBuilder::build<Type>(storage, _resource) };
+				newCluster = &_insert(ClusterBuilder::share(std::move(cluster), key.shared));
+			}
+
+			if (oldCluster)
+			{
+				_move(*oldCluster, *newCluster, ClusterBridge::map(*oldCluster, *newCluster), id);
+			}
+			else
+			{
+				newCluster->pushEntity(id);
+				_entity(id).cluster = newCluster;
+				_entity(id).index = newCluster->size() - 1;
+			}
+
+			if (!exists)
+			{
+				observers.added(id, componentID);
+			}
+		}
+
+		template<typename Type>
+		static auto _table(Type& component)
+		{
+			if constexpr (_separate<Type>())
+			{
+				return std::tuple<>{};
+			}
+			else
+			{
+				return std::tuple<Type&&>{ std::move(component) };
+			}
+		}
+
+		template<typename Type>
+		std::pair<SparseSet*, size_t> _sparseComponent(EntityID id)
+		{
+			_checked(id);
+
+			auto result{ sparseSets.find(ComponentRegistry<Type>::id) };
+			size_t index{ result == sparseSets.end() ? SparseSet::NONE : result->second.find(id) };
+			if (index == SparseSet::NONE)
+			{
+				throw std::out_of_range{ "Entity does not have the component" };
+			}
+			return { &result->second, index };
+		}
+
+		template<typename Type>
+		SparseSet* _findSparse()
+		{
+			if constexpr (ComponentRegistry<Type>::sparse)
+			{
+				auto result{ sparseSets.find(ComponentRegistry<Type>::id) };
+				return result == sparseSets.end() ? nullptr : &result->second;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		template<typename Less>
+		void _sort(Cluster& cluster, const Less& less, SortMode mode)
+		{
+			size_t size{ cluster.size() };
+			if (size < 2)
+			{
+				return;
+			}
+
+			std::vector<size_t> order(size);
+			std::iota(order.begin(), order.end(), size_t{ 0 });
+
+			if (mode == SortMode::INCREMENTAL)
+			{
+				for (size_t index{ 1 }; index < size; ++index)
+				{
+					size_t row{ order[index] };
+					size_t position{ index };
+					for (; position > 0 && less(row, order[position - 1]); --position)
+					{
+						order[position] = order[position - 1];
+					}
+					order[position] = row;
+				}
+			}
+			else
+			{
+				std::stable_sort(order.begin(), order.end(), less);
+			}
+
+			if (std::is_sorted(order.begin(), order.end()))
+			{
+				return;
+			}
+
+			cluster.permute(order);
+
+			for (size_t index{}; index < size; ++index)
+			{
+				if (order[index] != index)
+				{
+					_entity(cluster.entities()[index]).index = index;
+				}
+			}
+		}
+
+		template<typename... Types>
+		void _reindex(EntityID id)
+		{
+			if (!indexes.empty())
+			{
+				(_reindex(id, ComponentRegistry<Types>::id), ...);
+			}
+		}
+
+		void _reindex(EntityID id, ComponentID component)
+		{
+			if (ComponentIndex* index{ indexes.find(component) })
+			{
+				if (const void* address{ _address(id, component) })
+				{
+					index->insert(id, address);
+				}
+			}
+		}
+
+		const void* _address(EntityID id, ComponentID component)
+		{
+			auto sparse{ sparseSets.find(component) };
+			if (sparse != sparseSets.end())
+			{
+				size_t index{ sparse->second.find(id) };
+				return index != SparseSet::NONE ? sparse->second.data().at(index) : nullptr;
+			}
+
+			const EntityData& data{ _entity(id) };
+			if (!data.cluster || !data.cluster->signature().test(component))
+			{
+				return nullptr;
+			}
+
+			if (const void* shared{ data.cluster->shared(component) })
+			{
+				return shared;
+			}
+
+			const Column* column{ data.cluster->lookup(component) };
+			return column ? column->at(data.index) : nullptr;
+		}
+
+		void _eraseSparse(EntityID id)
+		{
+			for (auto& pair : sparseSets)
+			{
+				if (pair.second.erase(id))
+				{
+					observers.removed(id, pair.first);
+				}
+			}
+		}
+
+		template<typename... Types>
+		void _attach(Cluster& cluster, const Signature& existing, Types&&... components)
+		{
+			size_t index{ cluster.size() - 1 };
+			(_attachComponent<Types>(cluster, existing.test(ComponentRegistry<Types>::id), index, std::move(components)), ...);
+
+			((existing.test(ComponentRegistry<Types>::id) ?
+				void() :
+				observers.added(cluster.entities()[index], ComponentRegistry<Types>::id)), ...);
+		}
+
+		template<typename Type>
+		void _attachComponent(Cluster& cluster, bool exists, size_t index, Type&& component)
+		{
+			if constexpr (!ComponentRegistry<Type>::tag)
+			{
+				if (exists)
+				{
+					cluster.get<Type>(index) = std::move(component);
+					cluster.markChanged(ComponentRegistry<Type>::id, index, _tick);
+				}
+				else
+				{
+					cluster.push<Type>(std::move(component));
+					cluster.markAdded(ComponentRegistry<Type>::id, index, _tick);
+				}
 			}
 		}
 
 		template<typename... Types>
-		void _attach(Cluster& cluster, Types&&... components)
+		void _assign(Cluster& cluster, size_t index, Types&&... components)
 		{
-			(cluster.push<Types>(std::move(components)),...);
+			(_attachComponent<Types>(cluster, true, index, std::move(components)), ...);
 		}
 	};
 
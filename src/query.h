@@ -1,6 +1,11 @@
 #ifndef BYTE_ECS_QUERY_H
 #define	BYTE_ECS_QUERY_H
 
+#include <unordered_map>
+#include <memory_resource>
+#include <shared_mutex>
+#include <mutex>
+
 #include "cluster.h"
 
 namespace Byte::ECS
@@ -23,11 +28,11 @@ namespace Byte::ECS
 			return out;
 		}
 
-		static ClusterGroup include(ClusterGroup& clusters, const Signature& signature)
+		static ClusterGroup include(const ClusterGroup& clusters, const Signature& signature)
 		{
 			ClusterGroup out;
 
-			for (auto& cluster: clusters)
+			for (auto cluster: clusters)
 			{
 				if (cluster->signature().includes(signature) && !cluster->empty())
 				{
@@ -53,11 +58,11 @@ namespace Byte::ECS
 			return out;
 		}
 
-		static ClusterGroup exclude(ClusterGroup& clusters, const Signature& signature)
+		static ClusterGroup exclude(const ClusterGroup& clusters, const Signature& signature)
 		{
 			ClusterGroup out;
 
-			for (auto& cluster : clusters)
+			for (auto cluster : clusters)
 			{
 				if (!cluster->signature().matches(signature) && !cluster->empty())
 				{
@@ -67,6 +72,182 @@ namespace Byte::ECS
 
 			return out;
 		}
+
+		template<typename Type>
+		static ClusterGroup shared(const ClusterGroup& clusters, const Type& value)
+		{
+			ClusterGroup out;
+
+			for (auto cluster : clusters)
+			{
+				const void* current{ cluster->shared(ComponentRegistry<Type>::id) };
+				if (current && *static_cast<const Type*>(current) == value && !cluster->empty())
+				{
+					out.push_back(cluster);
+				}
+			}
+
+			return out;
+		}
+	};
+
+	struct QueryKey
+	{
+		Signature include;
+		Signature exclude;
+
+		bool operator==(const QueryKey& left) const
+		{
+			return include == left.include && exclude == left.exclude;
+		}
+
+		bool operator!=(const QueryKey& left) const
+		{
+			return !(*this == left);
+		}
+	};
+
+}
+
+namespace std
+{
+
+	template<>
+	struct hash<Byte::ECS::QueryKey>
+	{
+		size_t operator()(const Byte::ECS::QueryKey& key) const
+		{
+			hash<Byte::ECS::Signature> hasher;
+			return hasher(key.include) ^ (hasher(key.exclude) << 1);
+		}
+	};
+
+}
+
+namespace Byte::ECS
+{
+
+	class QueryCache
+	{
+	private:
+		QueryKey _key;
+		ClusterGroup _clusters;
+
+	public:
+		QueryCache(const QueryKey& key, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			:_key{ key }, _clusters{ resource }
+		{
+		}
+
+		const QueryKey& key() const
+		{
+			return _key;
+		}
+
+		const ClusterGroup& clusters() const
+		{
+			return _clusters;
+		}
+
+		bool test(const Cluster& cluster) const
+		{
+			return cluster.signature().includes(_key.include) && !cluster.signature().matches(_key.exclude);
+		}
+
+		void push(Cluster& cluster)
+		{
+			if (test(cluster))
+			{
+				_clusters.push_back(&cluster);
+			}
+		}
+
+		void clear()
+		{
+			_clusters.clear();
+		}
+	};
+
+	class QueryRegistry
+	{
+	private:
+		using QueryContainer = std::pmr::unordered_map<QueryKey, QueryCache>;
+
+	private:
+		QueryContainer queries;
+		mutable std::shared_mutex mutex;
+
+	public:
+		QueryRegistry(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			:queries{ resource }
+		{
+		}
+
+		QueryRegistry(const QueryRegistry& left)
+			:queries{ left.queries.get_allocator() }
+		{
+		}
+
+		QueryRegistry(QueryRegistry&& right) noexcept
+			:queries{ std::move(right.queries) }
+		{
+		}
+
+		QueryRegistry& operator=(const QueryRegistry&)
+		{
+			std::unique_lock<std::shared_mutex> lock{ mutex };
+			queries.clear();
+			return *this;
+		}
+
+		QueryRegistry& operator=(QueryRegistry&& right) noexcept
+		{
+			std::unique_lock<std::shared_mutex> lock{ mutex };
+			queries = std::move(right.queries);
+			return *this;
+		}
+
+		template<typename Container>
+		QueryCache& get(const QueryKey& key, Container& clusters)
+		{
+			{
+				std::shared_lock<std::shared_mutex> lock{ mutex };
+				auto result{ queries.find(key) };
+				if (result != queries.end())
+				{
+					return result->second;
+				}
+			}
+
+			std::unique_lock<std::shared_mutex> lock{ mutex };
+			auto [result, inserted] { queries.try_emplace(key, key, queries.get_allocator().resource()) };
+			if (inserted)
+			{
+				for (auto& pair : clusters)
+				{
+					result->second.push(pair.second);
+				}
+			}
+			return result->second;
+		}
+
+		void push(Cluster& cluster)
+		{
+			std::unique_lock<std::shared_mutex> lock{ mutex };
+			for (auto& pair : queries)
+			{
+				pair.second.push(cluster);
+			}
+		}
+
+		void clear()
+		{
+			std::unique_lock<std::shared_mutex> lock{ mutex };
+			for (auto& pair : queries)
+			{
+				pair.second.clear();
+			}
+		}
 	};
 
 }
@@ -0,0 +1,221 @@
+#ifndef BYTE_ECS_RESOURCE_H
+#define BYTE_ECS_RESOURCE_H
+
+#include <vector>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include "component.h"
+#include "typedefs.h"
+
+namespace Byte::ECS
+{
+
+	class ResourceRegistry
+	{
+	private:
+		struct Entry
+		{
+			void* data{ nullptr };
+			const ComponentInfo* info{ nullptr };
+		};
+
+		using EntryContainer = std::pmr::vector<Entry>;
+
+	private:
+		std::pmr::memory_resource* _resource;
+		EntryContainer entries;
+
+	public:
+		ResourceRegistry(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			:_resource{ resource }, entries{ resource }
+		{
+		}
+
+		ResourceRegistry(const ResourceRegistry& left)
+			:_resource{ left._resource }, entries{ left._resource }
+		{
+			try
+			{
+				copy(left);
+			}
+			catch (...)
+			{
+				clear();
+				throw;
+			}
+		}
+
+		ResourceRegistry(ResourceRegistry&& right) noexcept
+			:_resource{ right._resource }, entries{ std::move(right.entries) }
+		{
+			right.entries.clear();
+		}
+
+		~ResourceRegistry()
+		{
+			clear();
+		}
+
+		ResourceRegistry& operator=(const ResourceRegistry& left)
+		{
+			if (this != &left)
+			{
+				*this = ResourceRegistry{ left };
+			}
+			return *this;
+		}
+
+		ResourceRegistry& operator=(ResourceRegistry&& right) noexcept
+		{
+			if (this != &right)
+			{
+				clear();
+				_resource = right._resource;
+				entries = std::move(right.entries);
+				right.entries.clear();
+			}
+			return *this;
+		}
+
+		template<typename Type, typename... Args>
+		Type& emplace(Args&&... args)
+		{
+			static_assert(!std::is_const_v<Type>, "Resources are emplaced by their mutable type");
+
+			ComponentID id{ ComponentRegistry<Type>::id };
+			if (id >= entries.size())
+			{
+				entries.resize(static_cast<size_t>(id) + 1);
+			}
+
+			Entry& entry{ entries[id] };
+			if (entry.data)
+			{
+				entry.info->destroy(entry.data);
+			}
+			else
+			{
+				entry.data = _resource->allocate(sizeof(Type), alignof(Type));
+				entry.info = &ComponentRegistry<Type>::info;
+			}
+
+			try
+			{
+				return *::new (entry.data) Type(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				_resource->deallocate(entry.data, sizeof(Type), alignof(Type));
+				entry = Entry{};
+				throw;
+			}
+		}
+
+		template<typename Type>
+		Type* find()
+		{
+			ComponentID id{ ComponentRegistry<Type>::id };
+			return id < entries.size() ? static_cast<Type*>(entries[id].data) : nullptr;
+		}
+
+		template<typename Type>
+		const Type* find() const
+		{
+			return const_cast<ResourceRegistry&>(*this).find<const Type>();
+		}
+
+		template<typename Type>
+		Type& get()
+		{
+			Type* out{ find<Type>() };
+			if (!out)
+			{
+				throw std::out_of_range{ "Pool does not have the resource" };
+			}
+			return *out;
+		}
+
+		template<typename Type>
+		const Type& get() const
+		{
+			return const_cast<ResourceRegistry&>(*this).get<const Type>();
+		}
+
+		template<typename Type>
+		bool contains() const
+		{
+			return find<Type>() != nullptr;
+		}
+
+		template<typename Type>
+		bool erase()
+		{
+			ComponentID id{ ComponentRegistry<Type>::id };
+			if (id >= entries.size() || !entries[id].data)
+			{
+				return false;
+			}
+
+			release(entries[id]);
+			return true;
+		}
+
+		void clear()
+		{
+			for (auto& entry : entries)
+			{
+				if (entry.data)
+				{
+					release(entry);
+				}
+			}
+			entries.clear();
+		}
+
+	private:
+		void copy(const ResourceRegistry& left)
+		{
+			entries.resize(left.entries.size());
+			for (size_t id{}; id < left.entries.size(); ++id)
+			{
+				const Entry& source{ left.entries[id] };
+				if (!source.data)
+				{
+					continue;
+				}
+
+				if (!source.info->copy)
+				{
+					throw std::logic_error{ "Resource is not copy constructible" };
+				}
+
+				void* data{ _resource->allocate(source.info->size, source.info->alignment) };
+				try
+				{
+					source.info->copy(data, source.data);
+				}
+				catch (...)
+				{
+					_resource->deallocate(data, source.info->size, source.info->alignment);
+					throw;
+				}
+
+				entries[id] = Entry{ data, source.info };
+			}
+		}
+
+		void release(Entry& entry)
+		{
+			entry.info->destroy(entry.data);
+			_resource->deallocate(entry.data, entry.info->size, entry.info->alignment);
+			entry = Entry{};
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,336 @@
+#ifndef BYTE_ECS_SCHEDULER_H
+#define BYTE_ECS_SCHEDULER_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <mutex>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+
+#include "pool.h"
+#include "signature.h"
+#include "component.h"
+#include "thread_pool.h"
+
+namespace Byte::ECS
+{
+
+	template<typename Type>
+	struct Read
+	{
+	};
+
+	template<typename Type>
+	struct Write
+	{
+	};
+
+	struct Access
+	{
+		Signature read;
+		Signature write;
+
+		bool conflicts(const Access& left) const
+		{
+			return write.matches(left.write) || write.matches(left.read) || read.matches(left.write);
+		}
+	};
+
+	template<typename Type>
+	struct _AccessTraits;
+
+	template<typename Type>
+	struct _AccessTraits<Read<Type>>
+	{
+		static void set(Access& access)
+		{
+			access.read.set(ComponentRegistry<Type>::id);
+		}
+	};
+
+	template<typename Type>
+	struct _AccessTraits<Write<Type>>
+	{
+		static void set(Access& access)
+		{
+			access.write.set(ComponentRegistry<Type>::id);
+		}
+	};
+
+	template<typename... Types>
+	struct AccessBuilder
+	{
+		operator Access() const
+		{
+			Access out;
+			(_AccessTraits<Types>::set(out), ...);
+			return out;
+		}
+	};
+
+	using SystemID = size_t;
+
+	struct SystemStats
+	{
+		using Duration = std::chrono::steady_clock::duration;
+
+		SystemID id{ 0 };
+		Duration start{};
+		Duration finish{};
+	};
+
+	struct FrameStats
+	{
+		using Duration = std::chrono::steady_clock::duration;
+
+		Duration frame{};
+		Duration criticalPath{};
+		std::vector<SystemID> criticalSystems;
+		std::vector<SystemStats> systems;
+	};
+
+	class Scheduler
+	{
+	private:
+		using Callable = std::function<void(Pool&)>;
+		using Clock = std::chrono::steady_clock;
+		using IDContainer = std::vector<SystemID>;
+
+		struct SystemData
+		{
+			std::string name;
+			Access access;
+			Callable callable;
+			IDContainer after;
+		};
+
+		struct Graph
+		{
+			IDContainer order;
+			std::vector<IDContainer> dependents;
+			std::vector<IDContainer> dependencies;
+		};
+
+		using SystemContainer = std::vector<SystemData>;
+
+	private:
+		SystemContainer systems;
+
+	public:
+		template<typename... Accesses, typename Function>
+		SystemID add(std::string name, Function&& function)
+		{
+			systems.push_back(SystemData{ std::move(name), AccessBuilder<Accesses...>{}, std::forward<Function>(function), {} });
+			return systems.size() - 1;
+		}
+
+		void order(SystemID first, SystemID second)
+		{
+			systems.at(second).after.push_back(first);
+		}
+
+		const std::string& name(SystemID id) const
+		{
+			return systems.at(id).name;
+		}
+
+		const Access& access(SystemID id) const
+		{
+			return systems.at(id).access;
+		}
+
+		size_t size() const
+		{
+			return systems.size();
+		}
+
+		FrameStats run(Pool& pool)
+		{
+			return run(pool, ThreadPool::global());
+		}
+
+		FrameStats run(Pool& pool, ThreadPool& executor)
+		{
+			Graph graph{ build() };
+
+			size_t count{ systems.size() };
+			std::unique_ptr<std::atomic<size_t>[]> waiting{ new std::atomic<size_t>[count] };
+			std::atomic<size_t> remaining{ count };
+			std::exception_ptr error;
+			std::mutex errorMutex;
+
+			FrameStats out;
+			out.systems.resize(count);
+
+			Clock::time_point start{ Clock::now() };
+
+			std::function<void(SystemID)> launch;
+			launch = [&](SystemID id)
+				{
+					executor.submit([&, id]()
+						{
+							out.systems[id].id = id;
+							out.systems[id].start = Clock::now() - start;
+
+							try
+							{
+								systems[id].callable(pool);
+							}
+							catch (...)
+							{
+								std::lock_guard<std::mutex> lock{ errorMutex };
+								if (!error)
+								{
+									error = std::current_exception();
+								}
+							}
+
+							out.systems[id].finish = Clock::now() - start;
+
+							for (auto dependent : graph.dependents[id])
+							{
+								if (--waiting[dependent] == 0)
+								{
+									launch(dependent);
+								}
+							}
+
+							if (--remaining == 0)
+							{
+								executor.notify();
+							}
+						});
+				};
+
+			for (SystemID id{}; id < count; ++id)
+			{
+				waiting[id] = graph.dependencies[id].size();
+			}
+
+			for (SystemID id{}; id < count; ++id)
+			{
+				if (graph.dependencies[id].empty())
+				{
+					launch(id);
+				}
+			}
+
+			executor.wait([&]() { return remaining == 0; });
+
+			out.frame = Clock::now() - start;
+			measure(graph, out);
+
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+
+			return out;
+		}
+
+	private:
+		Graph build() const
+		{
+			size_t count{ systems.size() };
+
+			Graph out;
+			out.dependents.resize(count);
+			out.dependencies.resize(count);
+
+			std::vector<uint8_t> state(count, 0);
+			for (SystemID id{}; id < count; ++id)
+			{
+				place(id, state, out.order);
+			}
+
+			for (size_t second{}; second < count; ++second)
+			{
+				SystemID to{ out.order[second] };
+				for (size_t first{}; first < second; ++first)
+				{
+					SystemID from{ out.order[first] };
+					const IDContainer& after{ systems[to].after };
+
+					if (systems[from].access.conflicts(systems[to].access) || std::find(after.begin(), after.end(), from) != after.end())
+					{
+						out.dependents[from].push_back(to);
+						out.dependencies[to].push_back(from);
+					}
+				}
+			}
+
+			return out;
+		}
+
+		void place(SystemID id, std::vector<uint8_t>& state, IDContainer& order) const
+		{
+			if (state[id] == 2)
+			{
+				return;
+			}
+
+			if (state[id] == 1)
+			{
+				throw std::logic_error{ "Cyclic system ordering" };
+			}
+
+			state[id] = 1;
+			for (auto before : systems[id].after)
+			{
+				place(before, state, order);
+			}
+
+			state[id] = 2;
+			order.push_back(id);
+		}
+
+		void measure(const Graph& graph, FrameStats& stats) const
+		{
+			size_t count{ systems.size() };
+			std::vector<SystemStats::Duration> length(count);
+			std::vector<SystemID> previous(count, count);
+
+			SystemID last{ count };
+			for (auto id : graph.order)
+			{
+				SystemStats::Duration longest{};
+				for (auto dependency : graph.dependencies[id])
+				{
+					if (length[dependency] > longest)
+					{
+						longest = length[dependency];
+						previous[id] = dependency;
+					}
+				}
+
+				length[id] = longest + (stats.systems[id].finish - stats.systems[id].start);
+
+				if (last == count || length[id] > length[last])
+				{
+					last = id;
+				}
+			}
+
+			for (SystemID id{ last }; id != count; id = previous[id])
+			{
+				stats.criticalSystems.push_back(id);
+			}
+
+			std::reverse(stats.criticalSystems.begin(), stats.criticalSystems.end());
+
+			if (last != count)
+			{
+				stats.criticalPath = length[last];
+			}
+		}
+	};
+
+}
+
+#endif
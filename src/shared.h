@@ -0,0 +1,87 @@
+#ifndef BYTE_ECS_SHARED_H
+#define BYTE_ECS_SHARED_H
+
+#include <unordered_map>
+#include <memory_resource>
+#include <functional>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+
+#include "cluster.h"
+#include "column.h"
+#include "component.h"
+#include "typedefs.h"
+
+namespace Byte::ECS
+{
+
+	class SharedRegistry
+	{
+	private:
+		struct Values
+		{
+			Column column;
+			std::pmr::unordered_multimap<size_t, uint32_t> lookup;
+
+			Values(const ComponentInfo& info, std::pmr::memory_resource* resource)
+				:column{ info, CHUNK_CAPACITY, resource }, lookup{ resource }
+			{
+			}
+		};
+
+		using ValueContainer = std::pmr::unordered_map<ComponentID, Values>;
+
+	public:
+		inline static constexpr size_t CHUNK_CAPACITY{ 64 };
+
+	private:
+		std::pmr::memory_resource* _resource;
+		ValueContainer values;
+
+	public:
+		SharedRegistry(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			:_resource{ resource }, values{ resource }
+		{
+		}
+
+		template<typename Type>
+		SharedValue intern(Type&& value)
+		{
+			using Value = std::remove_cvref_t<Type>;
+
+			ComponentID id{ ComponentRegistry<Value>::id };
+			auto result{ values.find(id) };
+			if (result == values.end())
+			{
+				result = values.try_emplace(id, ComponentRegistry<Value>::info, _resource).first;
+			}
+
+			Values& entry{ result->second };
+			size_t hash{ std::hash<Value>{}(value) };
+
+			auto [begin, end] { entry.lookup.equal_range(hash) };
+			for (auto current{ begin }; current != end; ++current)
+			{
+				Value& existing{ entry.column.template get<Value>(current->second) };
+				if (existing == value)
+				{
+					return SharedValue{ id, current->second, &existing };
+				}
+			}
+
+			uint32_t index{ static_cast<uint32_t>(entry.column.size()) };
+			Value& stored{ entry.column.template emplace<Value>(std::forward<Type>(value)) };
+			entry.lookup.emplace(hash, index);
+			return SharedValue{ id, index, &stored };
+		}
+
+		void clear()
+		{
+			values.clear();
+		}
+	};
+
+}
+
+#endif
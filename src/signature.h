@@ -2,22 +2,171 @@
 #define BYTE_ECS_SIGNATURE_H
 
 #include <cstdint>
-#include <xhash>
+#include <functional>
 #include <vector>
 #include <bit>
 #include <algorithm>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BYTE_ECS_SIGNATURE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BYTE_ECS_SIGNATURE_SSE2
+#endif
+
 #include "component.h"
 #include "typedefs.h"
 
 namespace Byte::ECS
 {
-	
-	class Signature
+
+	struct _SignatureOps
+	{
+#if defined(BYTE_ECS_SIGNATURE_AVX2)
+		using Register = __m256i;
+		inline static constexpr size_t LANE_COUNT{ 4 };
+
+		static Register load(const size_t* data)
+		{
+			return _mm256_load_si256(reinterpret_cast<const Register*>(data));
+		}
+
+		static void store(size_t* data, Register value)
+		{
+			_mm256_store_si256(reinterpret_cast<Register*>(data), value);
+		}
+
+		static Register zero()
+		{
+			return _mm256_setzero_si256();
+		}
+
+		static Register bitOr(Register left, Register right)
+		{
+			return _mm256_or_si256(left, right);
+		}
+
+		static Register bitAnd(Register left, Register right)
+		{
+			return _mm256_and_si256(left, right);
+		}
+
+		static Register bitXor(Register left, Register right)
+		{
+			return _mm256_xor_si256(left, right);
+		}
+
+		static Register bitAndNot(Register left, Register right)
+		{
+			return _mm256_andnot_si256(left, right);
+		}
+
+		static bool none(Register value)
+		{
+			return _mm256_testz_si256(value, value);
+		}
+#elif defined(BYTE_ECS_SIGNATURE_SSE2)
+		using Register = __m128i;
+		inline static constexpr size_t LANE_COUNT{ 2 };
+
+		static Register load(const size_t* data)
+		{
+			return _mm_load_si128(reinterpret_cast<const Register*>(data));
+		}
+
+		static void store(size_t* data, Register value)
+		{
+			_mm_store_si128(reinterpret_cast<Register*>(data), value);
+		}
+
+		static Register zero()
+		{
+			return _mm_setzero_si128();
+		}
+
+		static Register bitOr(Register left, Register right)
+		{
+			return _mm_or_si128(left, right);
+		}
+
+		static Register bitAnd(Register left, Register right)
+		{
+			return _mm_and_si128(left, right);
+		}
+
+		static Register bitXor(Register left, Register right)
+		{
+			return _mm_xor_si128(left, right);
+		}
+
+		static Register bitAndNot(Register left, Register right)
+		{
+			return _mm_andnot_si128(left, right);
+		}
+
+		static bool none(Register value)
+		{
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_setzero_si128())) == 0xFFFF;
+		}
+#else
+		using Register = size_t;
+		inline static constexpr size_t LANE_COUNT{ 1 };
+
+		static Register load(const size_t* data)
+		{
+			return *data;
+		}
+
+		static void store(size_t* data, Register value)
+		{
+			*data = value;
+		}
+
+		static Register zero()
+		{
+			return 0;
+		}
+
+		static Register bitOr(Register left, Register right)
+		{
+			return left | right;
+		}
+
+		static Register bitAnd(Register left, Register right)
+		{
+			return left & right;
+		}
+
+		static Register bitXor(Register left, Register right)
+		{
+			return left ^ right;
+		}
+
+		static Register bitAndNot(Register left, Register right)
+		{
+			return ~left & right;
+		}
+
+		static bool none(Register value)
+		{
+			return value == 0;
+		}
+#endif
+	};
+
+	class alignas(64) Signature
 	{
+	private:
+		using Ops = _SignatureOps;
+		using Register = Ops::Register;
+
 	public:
-		inline static constexpr size_t BITSET_COUNT{ (MAX_COMPONENT_COUNT/64) + 1 };
 		inline static constexpr size_t BIT_COUNT{ 64 };
+		inline static constexpr size_t BITSET_COUNT
+		{
+			(((MAX_COMPONENT_COUNT + BIT_COUNT - 1) / BIT_COUNT + Ops::LANE_COUNT - 1) / Ops::LANE_COUNT) * Ops::LANE_COUNT
+		};
 
 	private:
 		using Container = size_t[BITSET_COUNT];
@@ -53,38 +202,32 @@ namespace Byte::ECS
 
 		bool includes(const Signature& signature) const
 		{
-			for (size_t index{}; index < BITSET_COUNT; ++index)
+			Register missing{ Ops::zero() };
+			for (size_t index{}; index < BITSET_COUNT; index += Ops::LANE_COUNT)
 			{
-				if ((_data[index] | signature._data[index]) != _data[index])
-				{
-					return false;
-				}
+				missing = Ops::bitOr(missing, Ops::bitAndNot(Ops::load(_data + index), Ops::load(signature._data + index)));
 			}
-			return true;
+			return Ops::none(missing);
 		}
 
 		bool matches(const Signature& signature) const
 		{
-			for (size_t index{}; index < BITSET_COUNT; ++index)
+			Register common{ Ops::zero() };
+			for (size_t index{}; index < BITSET_COUNT; index += Ops::LANE_COUNT)
 			{
-				if ((_data[index] & signature._data[index]) > 0)
-				{
-					return true;
-				}
+				common = Ops::bitOr(common, Ops::bitAnd(Ops::load(_data + index), Ops::load(signature._data + index)));
 			}
-			return false;
+			return !Ops::none(common);
 		}
 
 		bool any() const
 		{
-			for (size_t index{}; index < BITSET_COUNT; ++index)
+			Register result{ Ops::zero() };
+			for (size_t index{}; index < BITSET_COUNT; index += Ops::LANE_COUNT)
 			{
-				if (_data[index] > 0)
-				{
-					return true;
-				}
+				result = Ops::bitOr(result, Ops::load(_data + index));
 			}
-			return false;
+			return !Ops::none(result);
 		}
 
 		bool none() const
@@ -92,6 +235,18 @@ namespace Byte::ECS
 			return !any();
 		}
 
+		template<typename Callable>
+		void each(const Callable& callable) const
+		{
+			for (size_t index{}; index < BITSET_COUNT; ++index)
+			{
+				for (size_t bits{ _data[index] }; bits != 0; bits &= bits - 1)
+				{
+					callable(static_cast<ComponentID>(index * BIT_COUNT + std::countr_zero(bits)));
+				}
+			}
+		}
+
 		Container& data()
 		{
 			return _data;
@@ -107,16 +262,59 @@ namespace Byte::ECS
 			std::fill_n(_data, BITSET_COUNT, 0);
 		}
 
+		Signature& operator|=(const Signature& left)
+		{
+			for (size_t index{}; index < BITSET_COUNT; index += Ops::LANE_COUNT)
+			{
+				Ops::store(_data + index, Ops::bitOr(Ops::load(_data + index), Ops::load(left._data + index)));
+			}
+			return *this;
+		}
+
+		Signature& operator&=(const Signature& left)
+		{
+			for (size_t index{}; index < BITSET_COUNT; index += Ops::LANE_COUNT)
+			{
+				Ops::store(_data + index, Ops::bitAnd(Ops::load(_data + index), Ops::load(left._data + index)));
+			}
+			return *this;
+		}
+
+		Signature& operator-=(const Signature& left)
+		{
+			for (size_t index{}; index < BITSET_COUNT; index += Ops::LANE_COUNT)
+			{
+				Ops::store(_data + index, Ops::bitAndNot(Ops::load(left._data + index), Ops::load(_data + index)));
+			}
+			return *this;
+		}
+
+		Signature operator|(const Signature& left) const
+		{
+			Signature out{ *this };
+			return out |= left;
+		}
+
+		Signature operator&(const Signature& left) const
+		{
+			Signature out{ *this };
+			return out &= left;
+		}
+
+		Signature operator-(const Signature& left) const
+		{
+			Signature out{ *this };
+			return out -= left;
+		}
+
 		bool operator==(const Signature& left) const
 		{
-			for (size_t index{}; index < BITSET_COUNT; ++index)
+			Register difference{ Ops::zero() };
+			for (size_t index{}; index < BITSET_COUNT; index += Ops::LANE_COUNT)
 			{
-				if (_data[index] != left._data[index])
-				{
-					return false;
-				}
+				difference = Ops::bitOr(difference, Ops::bitXor(Ops::load(_data + index), Ops::load(left._data + index)));
 			}
-			return true;
+			return Ops::none(difference);
 		}
 
 		bool operator!=(const Signature& left) const
@@ -146,14 +344,18 @@ namespace std
 	{
 		size_t operator()(const Byte::ECS::Signature& signature) const
 		{
-			size_t result{};
+			uint64_t result{ 0x9E3779B97F4A7C15ULL };
 
 			for (size_t i{}; i < signature.BITSET_COUNT; ++i)
 			{
-				result += signature.data()[i];
+				result = std::rotl(result ^ static_cast<uint64_t>(signature.data()[i]), 27) * 0xFF51AFD7ED558CCDULL;
 			}
 
-			return result;
+			result ^= result >> 33;
+			result *= 0xC4CEB9FE1A85EC53ULL;
+			result ^= result >> 33;
+
+			return static_cast<size_t>(result);
 		}
 	};
 
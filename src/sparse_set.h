@@ -0,0 +1,152 @@
+#ifndef BYTE_ECS_SPARSE_SET_H
+#define BYTE_ECS_SPARSE_SET_H
+
+#include <vector>
+#include <memory_resource>
+#include <utility>
+#include <cstdint>
+
+#include "column.h"
+#include "component.h"
+#include "entity.h"
+#include "typedefs.h"
+
+namespace Byte::ECS
+{
+
+	class SparseSet
+	{
+	private:
+		using EntityIDContainer = std::pmr::vector<EntityID>;
+		using IndexContainer = std::pmr::vector<uint32_t>;
+
+	public:
+		inline static constexpr size_t NONE{ UINT32_MAX };
+
+	private:
+		Column column;
+		EntityIDContainer _entities;
+		IndexContainer sparse;
+
+	public:
+		SparseSet(const ComponentInfo& info, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			:column{ info, 0, resource }, _entities{ resource }, sparse{ resource }
+		{
+		}
+
+		const EntityIDContainer& entities() const
+		{
+			return _entities;
+		}
+
+		size_t size() const
+		{
+			return _entities.size();
+		}
+
+		bool empty() const
+		{
+			return _entities.empty();
+		}
+
+		size_t find(EntityID id) const
+		{
+			size_t index{ EntityHandle::index(id) };
+			if (index < sparse.size() && sparse[index] != NONE && _entities[sparse[index]] == id)
+			{
+				return sparse[index];
+			}
+			return NONE;
+		}
+
+		bool contains(EntityID id) const
+		{
+			return find(id) != NONE;
+		}
+
+		template<typename Type>
+		Type& get(size_t index)
+		{
+			return column.template get<Type>(index);
+		}
+
+		template<typename Type>
+		Type& get(size_t index, Tick tick)
+		{
+			column.markChanged(index, tick);
+			return column.template get<Type>(index);
+		}
+
+		const Column& data() const
+		{
+			return column;
+		}
+
+		template<typename Type>
+		bool emplace(EntityID id, Type&& component, Tick tick)
+		{
+			size_t index{ find(id) };
+			if (index != NONE)
+			{
+				get<Type>(index, tick) = std::move(component);
+				return false;
+			}
+
+			column.template emplace<Type>(std::move(component));
+			link(id, tick);
+			return true;
+		}
+
+		void copy(EntityID source, EntityID destination, Tick tick)
+		{
+			column.copyIn(column, find(source));
+			link(destination, tick);
+		}
+
+		bool erase(EntityID id)
+		{
+			size_t index{ find(id) };
+			if (index == NONE)
+			{
+				return false;
+			}
+
+			EntityID last{ _entities.back() };
+			column.remove(index);
+			_entities[index] = last;
+			sparse[EntityHandle::index(last)] = static_cast<uint32_t>(index);
+			_entities.pop_back();
+			sparse[EntityHandle::index(id)] = NONE;
+			return true;
+		}
+
+		void clear()
+		{
+			column.clear();
+			_entities.clear();
+			sparse.clear();
+		}
+
+		void compact()
+		{
+			column.compact();
+		}
+
+	private:
+		void link(EntityID id, Tick tick)
+		{
+			size_t index{ EntityHandle::index(id) };
+			if (index >= sparse.size())
+			{
+				sparse.resize(index + 1, NONE);
+			}
+
+			sparse[index] = static_cast<uint32_t>(_entities.size());
+			_entities.push_back(id);
+			column.markAdded(_entities.size() - 1, _entities.size(), tick);
+		}
+	};
+
+}
+
+#endif
@@ -1,12 +1,12 @@
 #ifndef BYTE_SPARCEVECTOR_H
 #define BYTE_SPARCEVECTOR_H
 
-#include <bitset>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <bit>
 #include <limits>
-#include <set>
+#include <algorithm>
 #include <type_traits>
 
 namespace Byte
@@ -18,8 +18,7 @@ namespace Byte
 	class sparse_vector_iterator
 	{
 	private:
-		using bitset64 = std::bitset<_BITSET_SIZE>;
-		using bitset_vector = std::conditional_t<std::is_const<T>::value, const std::vector<bitset64>, std::vector<bitset64>>;
+		using word_pointer = const uint64_t*;
 
 	public:
 		using iterator_category = std::forward_iterator_tag;
@@ -30,16 +29,19 @@ namespace Byte
 
 	private:
 		pointer data;
-		bitset_vector* bitsets_ptr;
+		word_pointer words;
+		size_t word_count;
 		size_t _index;
+		uint64_t word{ 0 };
 
 	public:
-		sparse_vector_iterator(T* data, size_t _index, bitset_vector* bitsets)
-			:data{ data }, _index{ _index }, bitsets_ptr{ bitsets }
+		sparse_vector_iterator(T* data, size_t _index, word_pointer words, size_t word_count)
+			:data{ data }, words{ words }, word_count{ word_count }, _index{ _index }
 		{
-			if (bitsets_ptr && !bitsets_ptr->at(_index / _BITSET_SIZE).test(_BITSET_SIZE - 1ULL - _index % _BITSET_SIZE))
+			if (_index < word_count * _BITSET_SIZE)
 			{
-				++(*this);
+				word = words[_index / _BITSET_SIZE] & (std::numeric_limits<uint64_t>::max() << (_index % _BITSET_SIZE));
+				seek();
 			}
 		}
 
@@ -55,32 +57,16 @@ namespace Byte
 
 		sparse_vector_iterator& operator++()
 		{
-			++_index;
-			for (size_t bitset_index{ _index / _BITSET_SIZE }; bitset_index < bitsets_ptr->size(); ++bitset_index)
-			{
-				size_t _bitset{ bitsets_ptr->at(bitset_index).to_ullong() };
-				size_t bit_count{ _index % 64 };
-				size_t mask{ bit_count == 0 ? std::numeric_limits<uint64_t>::max() : (1ULL << bit_count)};
-
-				_bitset &= mask;
-
-				size_t count{ static_cast<size_t>(std::countr_zero(_bitset)) };
-
-				if (count != _BITSET_SIZE)
-				{
-					_index = bitset_index * _BITSET_SIZE + count;
-					break;
-				}
-				_index += _BITSET_SIZE - _index % _BITSET_SIZE;
-			}
-
+			word &= word - 1;
+			seek();
 			return *this;
 		}
 
 		sparse_vector_iterator operator++(int)
 		{
+			sparse_vector_iterator out{ *this };
 			++(*this);
-			return sparse_vector_iterator{ *this };
+			return out;
 		}
 
 		bool operator==(const sparse_vector_iterator& left) const
@@ -97,16 +83,32 @@ namespace Byte
 		{
 			return _index;
 		}
+
+	private:
+		void seek()
+		{
+			size_t word_index{ _index / _BITSET_SIZE };
+
+			while (word == 0)
+			{
+				if (++word_index == word_count)
+				{
+					_index = word_count * _BITSET_SIZE;
+					return;
+				}
+				word = words[word_index];
+			}
+
+			_index = word_index * _BITSET_SIZE + static_cast<size_t>(std::countr_zero(word));
+		}
 	};
 
 	template<typename T, typename Allocator = std::allocator<T>>
 	class sparse_vector
 	{
 	private:
-		using bitset64 = std::bitset<_BITSET_SIZE>;
-		using bitset_vector = std::vector<bitset64>;
-		using index_set = std::set<size_t>;
 		using allocator_traits = std::allocator_traits<Allocator>;
+		using word_vector = std::vector<uint64_t, typename allocator_traits::template rebind_alloc<uint64_t>>;
 
 	public:
 		using value_type = T;
@@ -122,20 +124,18 @@ namespace Byte
 
 	private:
 		pointer _data{ nullptr };
-		bitset_vector bitsets;
-		index_set indices;
+		word_vector used;
+		word_vector free_blocks;
+		word_vector free_groups;
 		size_t _size{ 0 };
 		size_t _capacity{ 0 };
 		allocator_type allocator;
 
 	public:
-		sparse_vector(size_t initial_capacity = _BITSET_SIZE)
+		sparse_vector(size_t initial_capacity = _BITSET_SIZE, const allocator_type& alloc = allocator_type())
+			:used{ alloc }, free_blocks{ alloc }, free_groups{ alloc }, allocator{ alloc }
 		{
-			if (initial_capacity % _BITSET_SIZE != 0)
-			{
-				initial_capacity += _BITSET_SIZE - (initial_capacity % _BITSET_SIZE);
-			}
-			expand(initial_capacity);
+			expand(round(initial_capacity));
 		}
 
 		sparse_vector(const sparse_vector& left)
@@ -145,8 +145,9 @@ namespace Byte
 
 		sparse_vector(sparse_vector&& right) noexcept
 			:_data{ right._data },
-			bitsets{ std::move(right.bitsets) },
-			indices{ std::move(right.indices) },
+			used{ std::move(right.used) },
+			free_blocks{ std::move(right.free_blocks) },
+			free_groups{ std::move(right.free_groups) },
 			_size{ right._size },
 			_capacity{ right._capacity },
 			allocator{ std::move(right.allocator) }
@@ -156,25 +157,54 @@ namespace Byte
 			right._capacity = 0;
 		}
 
-		sparse_vector& operator=(const sparse_vector left)
+		~sparse_vector()
 		{
-			(*this) = left.copy();
+			release();
 		}
 
-		sparse_vector& operator=(sparse_vector&& right) noexcept
+		sparse_vector& operator=(const sparse_vector& left)
 		{
-			clear();
+			if (this != &left)
+			{
+				(*this) = left.copy();
+			}
+			return *this;
+		}
 
-			_data = right._data;
-			bitsets = std::move(right.bitsets);
-			indices = std::move(right.indices);
-			_size = right._size;
-			_capacity = right._capacity;
-			allocator = std::move(right.allocator);
+		sparse_vector& operator=(sparse_vector&& right)
+			noexcept(allocator_traits::propagate_on_container_move_assignment::value || allocator_traits::is_always_equal::value)
+		{
+			if (this != &right)
+			{
+				release();
 
-			right._data = nullptr;
-			right._size = 0;
-			right._capacity = 0;
+				if constexpr (!allocator_traits::propagate_on_container_move_assignment::value && !allocator_traits::is_always_equal::value)
+				{
+					if (allocator != right.allocator)
+					{
+						assign_from(std::move(right));
+						right.clear();
+						return *this;
+					}
+				}
+
+				_data = right._data;
+				used = std::move(right.used);
+				free_blocks = std::move(right.free_blocks);
+				free_groups = std::move(right.free_groups);
+				_size = right._size;
+				_capacity = right._capacity;
+
+				if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+				{
+					allocator = std::move(right.allocator);
+				}
+
+				right._data = nullptr;
+				right._size = 0;
+				right._capacity = 0;
+			}
+			return *this;
 		}
 
 		[[maybe_unused]] size_t push(const T& value)
@@ -198,6 +228,7 @@ namespace Byte
 
 		void insert(size_t index, T&& value)
 		{
+			reserve(index + 1);
 			_emplace(index, std::move(value));
 		}
 
@@ -205,24 +236,61 @@ namespace Byte
 		[[maybe_unused]] size_t emplace(Args&&... args)
 		{
 			size_t index{ free_index() };
-			_emplace(index, std::move(args)...);
+			_emplace(index, std::forward<Args>(args)...);
 
 			return index;
 		}
 
+		template<class Generator>
+		void emplace_n(size_t count, const Generator& generator)
+		{
+			reserve(_size + count);
+
+			while (count > 0)
+			{
+				size_t block{ free_block() };
+				uint64_t free{ ~used[block] };
+
+				for (; free != 0 && count > 0; --count)
+				{
+					size_t index{ block * _BITSET_SIZE + static_cast<size_t>(std::countr_zero(free)) };
+					free &= free - 1;
+
+					construct(&_data[index], generator(index));
+					++_size;
+				}
+
+				used[block] = ~free;
+
+				if (free == 0)
+				{
+					mark_full(block);
+				}
+			}
+		}
+
+		void reserve(size_t new_capacity)
+		{
+			if (new_capacity <= _capacity)
+			{
+				return;
+			}
+
+			expand(round(new_capacity));
+		}
+
 		void erase(size_t index)
 		{
-			size_t bitset_index{ index / _BITSET_SIZE };
-			size_t bit_index{ index % _BITSET_SIZE };
+			size_t block{ index / _BITSET_SIZE };
 
-			if (bitsets[bitset_index].all())
+			if (used[block] == std::numeric_limits<uint64_t>::max())
 			{
-				indices.insert(bitset_index);
+				mark_free(block);
 			}
 
-			bitsets[bitset_index].set(bit_index, false);
+			used[block] &= ~(uint64_t{ 1 } << (index % _BITSET_SIZE));
 
-			if (!std::is_trivially_destructible<T>::value)
+			if constexpr (!std::is_trivially_destructible_v<T>)
 			{
 				destroy(&_data[index]);
 			}
@@ -242,12 +310,12 @@ namespace Byte
 
 		reference operator[](size_t index)
 		{
-			return at(index);
+			return _data[index];
 		}
 
 		const_reference operator[](size_t index) const
 		{
-			return at(index);
+			return _data[index];
 		}
 
 		size_t size() const
@@ -267,96 +335,49 @@ namespace Byte
 
 		void clear()
 		{
-			if (!std::is_trivially_destructible<T>::value)
-			{
-				for (auto& item : *this)
-				{
-					destroy(&item);
-				}
-			}
-
-			indices.clear();
-			bitsets.clear();
-
-			indices.insert(0);
-			bitsets.emplace_back();
-
-			if (_capacity != _BITSET_SIZE)
-			{
-				allocator_traits::deallocate(allocator, _data, _capacity);
-				_data = allocator_traits::allocate(allocator, _BITSET_SIZE);
-				_capacity = _BITSET_SIZE;
-			}
-
-			_size = 0;
+			release();
+			expand(_BITSET_SIZE);
 		}
 
 		iterator begin()
 		{
-			return iterator{ _data, 0 , &bitsets };
+			return iterator{ _data, 0, used.data(), used.size() };
 		}
 
 		iterator end()
 		{
-			return iterator{ _data, bitsets.size() * _BITSET_SIZE, nullptr };
+			return iterator{ _data, used.size() * _BITSET_SIZE, used.data(), used.size() };
 		}
 
 		const_iterator begin() const
 		{
-			return const_iterator{ _data, 0 , &bitsets };
+			return const_iterator{ _data, 0, used.data(), used.size() };
 		}
 
 		const_iterator end() const
 		{
-			return const_iterator{ _data, bitsets.size() * _BITSET_SIZE, nullptr };
+			return const_iterator{ _data, used.size() * _BITSET_SIZE, used.data(), used.size() };
 		}
 
 		sparse_vector copy() const
 		{
-			sparse_vector out{ 0 };
-
-			out.bitsets = bitsets;
-			out.indices = indices;
-			out.allocator = allocator;
-
-			pointer out_data{ allocator_traits::allocate(out.allocator, _capacity) };
-
-			const_iterator _begin{ begin() };
-			const_iterator _end{ end() };
-
-			for (; _begin != _end; ++_begin)
-			{
-				out_data[_begin.index()] = *_begin;
-			}
-
-			out._data = out_data;
-			out._size = _size;
-			out._capacity = _capacity;
-
+			sparse_vector out{ 0, allocator };
+			out.release();
+			out.assign_from(*this);
 			return out;
 		}
 
 		void shrink_to_fit()
 		{
-			if (empty())
+			size_t word_count{ used.size() };
+			while (word_count > 1 && used[word_count - 1] == 0)
 			{
-				clear();
-				return;
+				--word_count;
 			}
 
-			size_t new_capacity{ _capacity };
-			for (size_t bitset_index{ bitsets.size() - 1 }; bitset_index > 0; --bitset_index)
+			if (word_count * _BITSET_SIZE != _capacity)
 			{
-				if (bitsets[bitset_index].any())
-				{
-					break;
-				}
-				new_capacity -= _BITSET_SIZE;
-			}
-
-			if (new_capacity != _capacity)
-			{
-				shrink(new_capacity);
+				relocate(word_count * _BITSET_SIZE);
 			}
 		}
 
@@ -365,111 +386,200 @@ namespace Byte
 			return _data;
 		}
 
-		const pointer data() const
+		const_pointer data() const
 		{
 			return _data;
 		}
 
 		bool test(size_t index) const
 		{
-			return bitsets[index / 64].test(index % 64);
+			return (used[index / _BITSET_SIZE] >> (index % _BITSET_SIZE)) & 1;
 		}
 
 	private:
+		static size_t round(size_t capacity)
+		{
+			return std::max<size_t>((capacity + _BITSET_SIZE - 1) / _BITSET_SIZE, 1) * _BITSET_SIZE;
+		}
+
+		static size_t words_for(size_t count)
+		{
+			return (count + _BITSET_SIZE - 1) / _BITSET_SIZE;
+		}
+
 		void expand(size_t new_capacity)
+		{
+			size_t old_words{ used.size() };
+
+			relocate(new_capacity);
+
+			for (size_t block{ old_words }; block < used.size(); ++block)
+			{
+				mark_free(block);
+			}
+		}
+
+		template<class Source>
+		void assign_from(Source&& source)
+		{
+			_data = allocator_traits::allocate(allocator, source._capacity);
+			_capacity = source._capacity;
+			used.assign(source.used.size(), 0);
+			free_blocks = source.free_blocks;
+			free_groups = source.free_groups;
+
+			for (auto it{ source.begin() }; it != source.end(); ++it)
+			{
+				if constexpr (std::is_const_v<std::remove_reference_t<Source>>)
+				{
+					construct(_data + it.index(), *it);
+				}
+				else
+				{
+					construct(_data + it.index(), std::move(*it));
+				}
+
+				used[it.index() / _BITSET_SIZE] |= uint64_t{ 1 } << (it.index() % _BITSET_SIZE);
+				++_size;
+			}
+		}
+
+		void relocate(size_t new_capacity)
 		{
 			pointer temp{ _data };
 
 			_data = allocator_traits::allocate(allocator, new_capacity);
 
-			for (size_t index{ 0 }; index < _size; ++index)
+			size_t word_count{ std::min(used.size(), words_for(new_capacity)) };
+			for (size_t block{ 0 }; block < word_count; ++block)
 			{
-				T& item{ temp[index] };
-				construct(_data + index, std::move(item));
-				destroy(temp + index);
+				for (uint64_t bits{ used[block] }; bits != 0; bits &= bits - 1)
+				{
+					size_t index{ block * _BITSET_SIZE + static_cast<size_t>(std::countr_zero(bits)) };
+					construct(_data + index, std::move(temp[index]));
+					destroy(temp + index);
+				}
 			}
 
-			allocator_traits::deallocate(allocator, temp, _capacity);
-
-			for (size_t bitset_index{ _capacity / _BITSET_SIZE }; bitset_index < new_capacity / _BITSET_SIZE; ++bitset_index)
+			if (temp)
 			{
-				indices.insert(bitset_index);
+				allocator_traits::deallocate(allocator, temp, _capacity);
 			}
 
-			bitsets.resize(new_capacity / _BITSET_SIZE);
+			used.resize(words_for(new_capacity), 0);
+			free_blocks.resize(words_for(used.size()), 0);
+			free_groups.resize(words_for(free_blocks.size()), 0);
+
+			if (new_capacity < _capacity)
+			{
+				std::fill(free_blocks.begin(), free_blocks.end(), 0);
+				std::fill(free_groups.begin(), free_groups.end(), 0);
+
+				for (size_t block{ 0 }; block < used.size(); ++block)
+				{
+					if (used[block] != std::numeric_limits<uint64_t>::max())
+					{
+						mark_free(block);
+					}
+				}
+			}
 
 			_capacity = new_capacity;
 		}
 
-		void shrink(size_t new_capacity)
+		void release()
 		{
-			pointer temp{ _data };
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				for (auto& item : *this)
+				{
+					destroy(&item);
+				}
+			}
+
+			if (_data)
+			{
+				allocator_traits::deallocate(allocator, _data, _capacity);
+			}
 
-			iterator it{ begin() };
-			iterator _end{ end() };
+			_data = nullptr;
+			used.clear();
+			free_blocks.clear();
+			free_groups.clear();
+			_size = 0;
+			_capacity = 0;
+		}
 
-			_data = allocator_traits::allocate(allocator, new_capacity);
+		void mark_free(size_t block)
+		{
+			size_t group{ block / _BITSET_SIZE };
 
-			for (; it != _end; ++it)
+			if (free_blocks[group] == 0)
 			{
-				construct(_data + it.index(), std::move(*it));
+				free_groups[group / _BITSET_SIZE] |= uint64_t{ 1 } << (group % _BITSET_SIZE);
 			}
 
-			allocator_traits::deallocate(allocator, temp, _capacity);
+			free_blocks[group] |= uint64_t{ 1 } << (block % _BITSET_SIZE);
+		}
+
+		void mark_full(size_t block)
+		{
+			size_t group{ block / _BITSET_SIZE };
 
-			indices.clear();
-			bitset_vector new_bitsets;
+			free_blocks[group] &= ~(uint64_t{ 1 } << (block % _BITSET_SIZE));
 
-			for (size_t bitset_index{ 0 }; bitset_index < new_capacity / _BITSET_SIZE; ++bitset_index)
+			if (free_blocks[group] == 0)
 			{
-				if (!bitsets[bitset_index].all())
+				free_groups[group / _BITSET_SIZE] &= ~(uint64_t{ 1 } << (group % _BITSET_SIZE));
+			}
+		}
+
+		size_t free_block() const
+		{
+			for (size_t top{ 0 }; top < free_groups.size(); ++top)
+			{
+				if (free_groups[top] != 0)
 				{
-					indices.insert(bitset_index);
+					size_t group{ top * _BITSET_SIZE + static_cast<size_t>(std::countr_zero(free_groups[top])) };
+					return group * _BITSET_SIZE + static_cast<size_t>(std::countr_zero(free_blocks[group]));
 				}
-				new_bitsets.push_back(bitsets[bitset_index]);
 			}
 
-			bitsets = new_bitsets;
-			_capacity = new_capacity;
+			return used.size();
 		}
 
 		template<class... Args>
 		void _emplace(size_t index, Args&&... args)
 		{
-			size_t bitset_index{ index / _BITSET_SIZE };
-			size_t bit_index{ index % _BITSET_SIZE };
+			size_t block{ index / _BITSET_SIZE };
+
+			construct(&_data[index], std::forward<Args>(args)...);
 
-			bitsets[bitset_index].set(bit_index);
+			used[block] |= uint64_t{ 1 } << (index % _BITSET_SIZE);
 
-			if (bitsets[bitset_index].all())
+			if (used[block] == std::numeric_limits<uint64_t>::max())
 			{
-				indices.erase(bitset_index);
+				mark_full(block);
 			}
 
-			construct(&_data[index], std::move(args)...);
-
 			++_size;
 		}
 
 		size_t free_index()
 		{
-			if (indices.empty())
+			if (_size == _capacity)
 			{
 				expand(2 * _capacity);
 			}
 
-			size_t bitset_index{ *indices.begin() };
-			size_t index{ static_cast<size_t>(std::countr_zero(~bitsets[bitset_index].to_ullong())) };
-
-			index += bitset_index * _BITSET_SIZE;
-
-			return index;
+			size_t block{ free_block() };
+			return block * _BITSET_SIZE + static_cast<size_t>(std::countr_zero(~used[block]));
 		}
 
 		template<class... Args>
 		void construct(T* address, Args&&... args)
 		{
-			allocator_traits::construct(allocator, address, std::move(args)...);
+			allocator_traits::construct(allocator, address, std::forward<Args>(args)...);
 		}
 
 		void destroy(T* address)
@@ -0,0 +1,271 @@
+#ifndef BYTE_ECS_THREAD_POOL_H
+#define BYTE_ECS_THREAD_POOL_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+namespace Byte::ECS
+{
+
+	class ThreadPool
+	{
+	public:
+		using Task = std::function<void()>;
+
+	private:
+		struct TaskQueue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		using QueueContainer = std::vector<std::unique_ptr<TaskQueue>>;
+		using WorkerContainer = std::vector<std::thread>;
+
+	private:
+		QueueContainer queues;
+		WorkerContainer workers;
+		std::atomic<size_t> pending{ 0 };
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool stopping{ false };
+
+		inline static thread_local ThreadPool* current{ nullptr };
+		inline static thread_local size_t currentIndex{ 0 };
+
+	public:
+		ThreadPool(size_t threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1))
+		{
+			threadCount = std::max<size_t>(threadCount, 1);
+
+			for (size_t index{}; index < threadCount; ++index)
+			{
+				queues.push_back(std::make_unique<TaskQueue>());
+			}
+
+			for (size_t index{ 1 }; index < threadCount; ++index)
+			{
+				workers.emplace_back([this, index]() { work(index); });
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock{ mutex };
+				stopping = true;
+			}
+
+			condition.notify_all();
+
+			for (auto& worker : workers)
+			{
+				worker.join();
+			}
+		}
+
+		size_t size() const
+		{
+			return workers.size() + 1;
+		}
+
+		void submit(Task task)
+		{
+			TaskQueue& queue{ *queues[localIndex()] };
+
+			{
+				std::lock_guard<std::mutex> lock{ queue.mutex };
+				queue.tasks.push_back(std::move(task));
+				++pending;
+			}
+
+			notify();
+		}
+
+		void notify()
+		{
+			{
+				std::lock_guard<std::mutex> lock{ mutex };
+			}
+			condition.notify_all();
+		}
+
+		template<typename Predicate>
+		void wait(const Predicate& done)
+		{
+			size_t index{ localIndex() };
+
+			while (!done())
+			{
+				if (runPending(index))
+				{
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock{ mutex };
+				condition.wait(lock, [&]() { return pending > 0 || done(); });
+			}
+		}
+
+		template<typename Callable>
+		void execute(size_t taskCount, const Callable& callable)
+		{
+			if (taskCount == 0)
+			{
+				return;
+			}
+
+			std::atomic<size_t> next{ 0 };
+			std::atomic<size_t> remaining{ std::min(taskCount, size()) - 1 };
+			std::exception_ptr error;
+			std::mutex errorMutex;
+
+			auto run
+			{
+				[&]()
+				{
+					for (size_t task{ next++ }; task < taskCount; task = next++)
+					{
+						try
+						{
+							callable(task);
+						}
+						catch (...)
+						{
+							std::lock_guard<std::mutex> lock{ errorMutex };
+							if (!error)
+							{
+								error = std::current_exception();
+							}
+						}
+					}
+				}
+			};
+
+			for (size_t index{ remaining.load() }; index > 0; --index)
+			{
+				submit([&, this]()
+					{
+						run();
+						if (--remaining == 0)
+						{
+							notify();
+						}
+					});
+			}
+
+			run();
+			wait([&]() { return remaining == 0; });
+
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+
+		static ThreadPool& global()
+		{
+			static ThreadPool instance;
+			return instance;
+		}
+
+	private:
+		size_t localIndex() const
+		{
+			return current == this ? currentIndex : 0;
+		}
+
+		bool runPending(size_t index)
+		{
+			Task task;
+
+			if (!pop(index, task))
+			{
+				for (size_t offset{ 1 }; offset < queues.size(); ++offset)
+				{
+					if (steal((index + offset) % queues.size(), task))
+					{
+						break;
+					}
+				}
+			}
+
+			if (!task)
+			{
+				return false;
+			}
+
+			task();
+			return true;
+		}
+
+		bool pop(size_t index, Task& task)
+		{
+			TaskQueue& queue{ *queues[index] };
+			std::lock_guard<std::mutex> lock{ queue.mutex };
+
+			if (queue.tasks.empty())
+			{
+				return false;
+			}
+
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			--pending;
+			return true;
+		}
+
+		bool steal(size_t index, Task& task)
+		{
+			TaskQueue& queue{ *queues[index] };
+			std::lock_guard<std::mutex> lock{ queue.mutex };
+
+			if (queue.tasks.empty())
+			{
+				return false;
+			}
+
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			--pending;
+			return true;
+		}
+
+		void work(size_t index)
+		{
+			current = this;
+			currentIndex = index;
+
+			while (true)
+			{
+				if (runPending(index))
+				{
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock{ mutex };
+				condition.wait(lock, [this]() { return stopping || pending > 0; });
+
+				if (stopping && pending == 0)
+				{
+					return;
+				}
+			}
+		}
+	};
+
+}
+
+#endif
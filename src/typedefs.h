@@ -2,16 +2,23 @@
 #define BYTE_ECS_TYPEDEFS_H
 
 #include <cstdint>
+#include <cstddef>
 #include <limits>
 
+#ifndef BYTE_ECS_MAX_COMPONENT_COUNT
+#define BYTE_ECS_MAX_COMPONENT_COUNT 1024
+#endif
+
 namespace Byte::ECS
 {
 
 	using EntityID = uint64_t;
 	using ComponentID = uint32_t;
+	using EntityVersion = uint32_t;
+	using Tick = uint32_t;
 
 	inline constexpr EntityID nullent{ std::numeric_limits<EntityID>::max() };
-	inline constexpr size_t MAX_COMPONENT_COUNT{ 1024 };
+	inline constexpr size_t MAX_COMPONENT_COUNT{ BYTE_ECS_MAX_COMPONENT_COUNT };
 
 }
 
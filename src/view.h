@@ -1,31 +1,216 @@
 #ifndef BYTE_ECS_VIEW_H
 #define BYTE_ECS_VIEW_H
 
+#include <tuple>
+#include <span>
+#include <vector>
+#include <array>
+#include <type_traits>
+
 #include "cluster.h"
+#include "sparse_set.h"
+#include "query.h"
 #include "typedefs.h"
 
 namespace Byte::ECS
 {
 
+	struct TickFilter
+	{
+		ComponentID id;
+		Tick since;
+		bool added;
+	};
+
+	using TickFilters = std::vector<TickFilter>;
+
+	template<typename Type>
+	Type& _element(Type* pointer, size_t index)
+	{
+		if constexpr (ComponentRegistry<Type>::shared || ComponentRegistry<Type>::tag)
+		{
+			return *pointer;
+		}
+		else
+		{
+			return pointer[index];
+		}
+	}
+
+	template<typename Type>
+	decltype(auto) _segment(Type* pointer, size_t offset, size_t size)
+	{
+		static_assert(!ComponentRegistry<Type>::tag, "Tag components have no storage to span, filter on them with include or exclude");
+
+		if constexpr (ComponentRegistry<Type>::shared)
+		{
+			return static_cast<Type&>(*pointer);
+		}
+		else
+		{
+			return std::span<Type>{ pointer + offset, size };
+		}
+	}
+
+	class _TickScan
+	{
+	private:
+		using ColumnContainer = std::vector<const Column*>;
+
+	private:
+		const TickFilters* filters{ nullptr };
+		ColumnContainer columns;
+
+	public:
+		_TickScan(const TickFilters* filters = nullptr)
+			:filters{ filters }
+		{
+		}
+
+		explicit operator bool() const
+		{
+			return filters != nullptr;
+		}
+
+		bool bind(const Cluster& cluster)
+		{
+			columns.clear();
+
+			for (auto& filter : *filters)
+			{
+				const Column* column{ cluster.lookup(filter.id) };
+				if (!column || (filter.added ? column->added() : column->changed()) <= filter.since)
+				{
+					return false;
+				}
+				columns.push_back(column);
+			}
+
+			return true;
+		}
+
+		size_t next(size_t index, size_t end) const
+		{
+			while (index < end)
+			{
+				if (!passesBlock(index / Column::TICK_BLOCK))
+				{
+					index = (index / Column::TICK_BLOCK + 1) * Column::TICK_BLOCK;
+				}
+				else if (passes(index))
+				{
+					return index;
+				}
+				else
+				{
+					++index;
+				}
+			}
+			return end;
+		}
+
+		size_t skip(size_t index, size_t end) const
+		{
+			while (index < end && passes(index))
+			{
+				++index;
+			}
+			return index;
+		}
+
+	private:
+		bool passesBlock(size_t index) const
+		{
+			for (size_t filter{}; filter < columns.size(); ++filter)
+			{
+				const TickFilter& current{ (*filters)[filter] };
+				Tick tick{ current.added ? columns[filter]->addedBlock(index) : columns[filter]->changedBlock(index) };
+				if (tick <= current.since)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool passes(size_t index) const
+		{
+			for (size_t filter{}; filter < columns.size(); ++filter)
+			{
+				const TickFilter& current{ (*filters)[filter] };
+				Tick tick{ current.added ? columns[filter]->added(index) : columns[filter]->changed(index) };
+				if (tick <= current.since)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
+	template<typename... Types, typename Callable>
+	void _eachSpan(const ClusterGroup& clusters, Tick tick, const TickFilters& filters, const Callable& callable)
+	{
+		_TickScan scan{ filters.empty() ? nullptr : &filters };
+
+		for (auto cluster : clusters)
+		{
+			if (cluster->empty() || (scan && !scan.bind(*cluster)))
+			{
+				continue;
+			}
+
+			ClusterCache<Types...> cache{ *cluster };
+			for (size_t chunk{}; chunk < cache.chunkCount(); ++chunk)
+			{
+				size_t base{ cache.chunkBase(chunk) };
+				size_t end{ base + cache.chunkSize(chunk) };
+
+				for (size_t begin{ scan ? scan.next(base, end) : base }; begin < end;)
+				{
+					size_t last{ scan ? scan.skip(begin, end) : end };
+
+					if (tick)
+					{
+						cache.eachMutable([&](Column& column) { column.markChanged(begin, last, tick); });
+					}
+
+					callable(cache, chunk, begin - base, last - begin);
+					begin = scan ? scan.next(last, end) : end;
+				}
+			}
+		}
+	}
+
 	template<typename... Types>
 	class _ViewIterator
 	{
 	protected:
 		using Cache = ClusterCache<Types...>;
+		using Chunk = std::tuple<Types*...>;
 
 	protected:
 		size_t index;
-		ClusterGroup* clusters;
+		const ClusterGroup* clusters;
 		Cache cache;
 		size_t cacheIndex;
+		size_t chunkIndex{ 0 };
+		size_t chunkSize{ 0 };
+		size_t runEnd{ 0 };
+		Chunk chunk{};
+		EntityID* entities{ nullptr };
+		Tick tick;
+		_TickScan scan;
 
 	public:
-		_ViewIterator(size_t index, ClusterGroup& clusterGroup, size_t cacheIndex)
-			:index{ index }, clusters{ &clusterGroup }, cacheIndex{ cacheIndex }
+		_ViewIterator(size_t index, const ClusterGroup& clusterGroup, size_t cacheIndex, Tick tick, const TickFilters* filters)
+			:index{ index }, clusters{ &clusterGroup }, cacheIndex{ cacheIndex }, tick{ tick }, scan{ filters }
 		{
-			if (cacheIndex < clusters->size())
+			seek();
+
+			if (scan)
 			{
-				cache = Cache{ *clusters->at(cacheIndex) };
+				settle();
 			}
 		}
 
@@ -34,33 +219,114 @@ namespace Byte::ECS
 		{
 			++index;
 
-			if (index == cache.size())
+			if (index == runEnd)
+			{
+				if (scan)
+				{
+					settle();
+				}
+				else
+				{
+					next();
+				}
+			}
+		}
+
+	private:
+		void seek()
+		{
+			while (cacheIndex < clusters->size() && !bind(*(*clusters)[cacheIndex]))
 			{
-				index = 0;
 				++cacheIndex;
-				if (cacheIndex != clusters->size())
+			}
+
+			if (cacheIndex < clusters->size())
+			{
+				cache = Cache{ *(*clusters)[cacheIndex] };
+				load();
+			}
+		}
+
+		bool bind(const Cluster& cluster)
+		{
+			return !cluster.empty() && (!scan || scan.bind(cluster));
+		}
+
+		void next()
+		{
+			index = 0;
+			++chunkIndex;
+
+			if (chunkIndex == cache.chunkCount())
+			{
+				chunkIndex = 0;
+				++cacheIndex;
+				seek();
+			}
+			else
+			{
+				load();
+			}
+		}
+
+		void load()
+		{
+			chunkSize = cache.chunkSize(chunkIndex);
+			runEnd = chunkSize;
+			chunk = cache.chunk(chunkIndex);
+			entities = cache.entityChunk(chunkIndex);
+
+			if (tick && !scan)
+			{
+				mark(0, chunkSize);
+			}
+		}
+
+		void settle()
+		{
+			while (cacheIndex < clusters->size())
+			{
+				size_t base{ cache.chunkBase(chunkIndex) };
+				size_t row{ scan.next(base + index, base + chunkSize) };
+
+				if (row < base + chunkSize)
 				{
-					cache = Cache{ *clusters->at(cacheIndex) };
+					index = row - base;
+					runEnd = scan.skip(row, base + chunkSize) - base;
+
+					if (tick)
+					{
+						mark(index, runEnd);
+					}
+					return;
 				}
+
+				next();
 			}
 		}
+
+		void mark(size_t begin, size_t end)
+		{
+			size_t base{ cache.chunkBase(chunkIndex) };
+			cache.eachMutable([&](Column& column) { column.markChanged(base + begin, base + end, tick); });
+		}
 	};
 
 	template<typename... Types>
 	class ViewIterator : public _ViewIterator<Types...>
 	{
 	private:
-		using ComponentGroup = ComponentGroup<Types...>;
+		using Group = ComponentGroup<Types...>;
 
 	public:
-		ViewIterator(size_t index, ClusterGroup& clusterGroup, size_t cacheIndex)
-			:_ViewIterator<Types...>{ index, clusterGroup, cacheIndex }
+		ViewIterator(size_t index, const ClusterGroup& clusterGroup, size_t cacheIndex, Tick tick = 0, const TickFilters* filters = nullptr)
+			:_ViewIterator<Types...>{ index, clusterGroup, cacheIndex, tick, filters }
 		{
 		}
 
-		ComponentGroup operator*()
+		Group operator*()
 		{
-			return this->cache.group(this->index);
+			return std::apply([this](Types*... pointers) { return Group(_element(pointers, this->index)...); }, this->chunk);
 		}
 
 		ViewIterator& operator++()
@@ -87,34 +353,98 @@ namespace Byte::ECS
 		using iterator = ViewIterator<Types...>;
 
 	private:
-		ClusterGroup clusters;
+		ClusterGroup owned;
+		const ClusterGroup* clusters;
+		Tick tick{ 0 };
+		TickFilters filters;
 
 	public:
-		View(const ClusterGroup& clusters)
-			: clusters{ clusters }
+		View(const ClusterGroup& clusters, Tick tick = 0)
+			: clusters{ &clusters }, tick{ tick }
+		{
+		}
+
+		View(ClusterGroup&& clusters, Tick tick = 0, TickFilters filters = {})
+			: owned{ std::move(clusters) }, clusters{ &owned }, tick{ tick }, filters{ std::move(filters) }
 		{
 		}
 
-		template<typename Type, typename... Types>
+		View(const View& left)
+			: owned{ left.owned }, clusters{ left.owns() ? &owned : left.clusters }, tick{ left.tick }, filters{ left.filters }
+		{
+		}
+
+		View(View&& right) noexcept
+			: owned{ std::move(right.owned) }, clusters{ right.owns() ? &owned : right.clusters },
+			tick{ right.tick }, filters{ std::move(right.filters) }
+		{
+		}
+
+		template<typename Type, typename... Others>
 		View include()
 		{
-			return View{ Query::include(clusters,SignatureBuilder<Type,Types...>{}) };
+			return View{ Query::include(*clusters,SignatureBuilder<Type,Others...>{}), tick, filters };
 		}
 
-		template<typename Type, typename... Types>
+		template<typename Type, typename... Others>
 		View exclude()
 		{
-			return View{ Query::exclude(clusters,SignatureBuilder<Type,Types...>{}) };
+			return View{ Query::exclude(*clusters,SignatureBuilder<Type,Others...>{}), tick, filters };
+		}
+
+		template<typename Type>
+		View changed(Tick since)
+		{
+			return filter<Type>(since, false);
+		}
+
+		template<typename Type>
+		View added(Tick since)
+		{
+			return filter<Type>(since, true);
+		}
+
+		template<typename Type>
+		View shared(const Type& value)
+		{
+			static_assert(ComponentRegistry<Type>::shared, "Only shared components can be matched by value");
+			return View{ Query::shared(*clusters, value), tick, filters };
+		}
+
+		template<typename Callable>
+		void eachChunk(const Callable& callable)
+		{
+			_eachSpan<Types...>(*clusters, tick, filters, [&](ClusterCache<Types...>& cache, size_t chunk, size_t offset, size_t size)
+				{
+					std::apply([&](Types*... pointers) { callable(_segment(pointers, offset, size)...); }, cache.chunk(chunk));
+				});
 		}
 
 		iterator begin()
 		{
-			return iterator{ 0,clusters,0 };
+			return iterator{ 0, *clusters, 0, tick, filters.empty() ? nullptr : &filters };
 		}
 
 		iterator end()
 		{
-			return iterator{ 0, clusters, clusters.size() };
+			return iterator{ 0, *clusters, clusters->size() };
+		}
+
+	private:
+		bool owns() const
+		{
+			return clusters == &owned;
+		}
+
+		template<typename Type>
+		View filter(Tick since, bool added)
+		{
+			static_assert(!ComponentRegistry<Type>::tag, "Tag components carry no change ticks");
+			static_assert(!ComponentRegistry<Type>::shared, "Shared components carry no change ticks");
+
+			TickFilters out{ filters };
+			out.push_back(TickFilter{ ComponentRegistry<Type>::id, since, added });
+			return View{ Query::include(*clusters, SignatureBuilder<Type>{}), tick, std::move(out) };
 		}
 	};
 
@@ -122,17 +452,17 @@ namespace Byte::ECS
 	class IDViewIterator: public _ViewIterator<Types...>
 	{
 	private:
-		using IDComponentGroup = IDComponentGroup<Types...>;
+		using IDGroup = IDComponentGroup<Types...>;
 
 	public:
-		IDViewIterator(size_t index, ClusterGroup& clusterGroup, size_t cacheIndex)
-			:_ViewIterator<Types...>{index, clusterGroup, cacheIndex}
+		IDViewIterator(size_t index, const ClusterGroup& clusterGroup, size_t cacheIndex, Tick tick = 0, const TickFilters* filters = nullptr)
+			:_ViewIterator<Types...>{index, clusterGroup, cacheIndex, tick, filters}
 		{
 		}
 
-		IDComponentGroup operator*()
+		IDGroup operator*()
 		{
-			return this->cache.groupWithID(this->index);
+			return std::apply([this](Types*... pointers) { return IDGroup(this->entities[this->index], _element(pointers, this->index)...); }, this->chunk);
 		}
 
 		IDViewIterator& operator++()
@@ -159,34 +489,321 @@ namespace Byte::ECS
 		using iterator = IDViewIterator<Types...>;
 
 	private:
-		ClusterGroup clusters;
+		ClusterGroup owned;
+		const ClusterGroup* clusters;
+		Tick tick{ 0 };
+		TickFilters filters;
 
 	public:
-		IDView(const ClusterGroup& clusters)
-			: clusters{clusters}
+		IDView(const ClusterGroup& clusters, Tick tick = 0)
+			: clusters{ &clusters }, tick{ tick }
+		{
+		}
+
+		IDView(ClusterGroup&& clusters, Tick tick = 0, TickFilters filters = {})
+			: owned{ std::move(clusters) }, clusters{ &owned }, tick{ tick }, filters{ std::move(filters) }
+		{
+		}
+
+		IDView(const IDView& left)
+			: owned{ left.owned }, clusters{ left.owns() ? &owned : left.clusters }, tick{ left.tick }, filters{ left.filters }
 		{
 		}
 
-		template<typename Type, typename... Types>
+		IDView(IDView&& right) noexcept
+			: owned{ std::move(right.owned) }, clusters{ right.owns() ? &owned : right.clusters },
+			tick{ right.tick }, filters{ std::move(right.filters) }
+		{
+		}
+
+		template<typename Type, typename... Others>
 		IDView include()
 		{
-			return IDView{ Query::include(clusters,SignatureBuilder<Type,Types...>{}) };
+			return IDView{ Query::include(*clusters,SignatureBuilder<Type,Others...>{}), tick, filters };
 		}
 
-		template<typename Type, typename... Types>
+		template<typename Type, typename... Others>
 		IDView exclude()
 		{
-			return IDView{ Query::exclude(clusters,SignatureBuilder<Type,Types...>{}) };
+			return IDView{ Query::exclude(*clusters,SignatureBuilder<Type,Others...>{}), tick, filters };
+		}
+
+		template<typename Type>
+		IDView changed(Tick since)
+		{
+			return filter<Type>(since, false);
+		}
+
+		template<typename Type>
+		IDView added(Tick since)
+		{
+			return filter<Type>(since, true);
+		}
+
+		template<typename Type>
+		IDView shared(const Type& value)
+		{
+			static_assert(ComponentRegistry<Type>::shared, "Only shared components can be matched by value");
+			return IDView{ Query::shared(*clusters, value), tick, filters };
+		}
+
+		template<typename Callable>
+		void eachChunk(const Callable& callable)
+		{
+			_eachSpan<Types...>(*clusters, tick, filters, [&](ClusterCache<Types...>& cache, size_t chunk, size_t offset, size_t size)
+				{
+					std::span<const EntityID> entities{ cache.entityChunk(chunk) + offset, size };
+					std::apply([&](Types*... pointers) { callable(entities, _segment(pointers, offset, size)...); }, cache.chunk(chunk));
+				});
+		}
+
+		iterator begin()
+		{
+			return iterator{ 0, *clusters, 0, tick, filters.empty() ? nullptr : &filters };
+		}
+
+		iterator end()
+		{
+			return iterator{ 0, *clusters, clusters->size() };
+		}
+
+	private:
+		bool owns() const
+		{
+			return clusters == &owned;
+		}
+
+		template<typename Type>
+		IDView filter(Tick since, bool added)
+		{
+			static_assert(!ComponentRegistry<Type>::tag, "Tag components carry no change ticks");
+			static_assert(!ComponentRegistry<Type>::shared, "Shared components carry no change ticks");
+
+			TickFilters out{ filters };
+			out.push_back(TickFilter{ ComponentRegistry<Type>::id, since, added });
+			return IDView{ Query::include(*clusters, SignatureBuilder<Type>{}), tick, std::move(out) };
+		}
+	};
+
+
+	template<typename... Types>
+	class JoinView;
+
+	template<typename... Types>
+	class JoinViewIterator
+	{
+	private:
+		using IDGroup = IDComponentGroup<Types...>;
+
+	private:
+		JoinView<Types...>* view;
+		size_t index;
+
+	public:
+		JoinViewIterator(JoinView<Types...>& view, size_t index)
+			:view{ &view }, index{ view.next(index) }
+		{
+		}
+
+		IDGroup operator*()
+		{
+			return view->group(index);
+		}
+
+		JoinViewIterator& operator++()
+		{
+			index = view->next(index + 1);
+			return *this;
+		}
+
+		bool operator==(const JoinViewIterator& left) const
+		{
+			return index == left.index;
+		}
+
+		bool operator!=(const JoinViewIterator& left) const
+		{
+			return !(*this == left);
+		}
+	};
+
+	template<typename... Types>
+	class JoinView
+	{
+		static_assert((ComponentRegistry<Types>::sparse || ...), "Joins need a sparse component, use Pool::components otherwise");
+
+	public:
+		using iterator = JoinViewIterator<Types...>;
+		using SetCache = std::array<SparseSet*, sizeof...(Types)>;
+
+	private:
+		using IDGroup = IDComponentGroup<Types...>;
+		using Sequence = std::index_sequence_for<Types...>;
+
+		friend class JoinViewIterator<Types...>;
+
+		inline static constexpr std::array<bool, sizeof...(Types)> SPARSE{ ComponentRegistry<Types>::sparse... };
+
+	private:
+		const EntityLocationContainer* locations;
+		SetCache sets;
+		SparseSet* driver{ nullptr };
+		Signature _include;
+		Signature _exclude;
+		bool located{ false };
+		Tick tick{ 0 };
+
+	public:
+		JoinView(const EntityLocationContainer& locations, const SetCache& sets, Tick tick = 0)
+			:locations{ &locations }, sets{ sets }, tick{ tick }
+		{
+			((ComponentRegistry<Types>::sparse ? void() : _include.set(ComponentRegistry<Types>::id)), ...);
+			located = _include.any();
+
+			for (size_t index{}; index < sets.size(); ++index)
+			{
+				if (!SPARSE[index])
+				{
+					continue;
+				}
+
+				if (!sets[index])
+				{
+					driver = nullptr;
+					break;
+				}
+
+				if (!driver || sets[index]->size() < driver->size())
+				{
+					driver = sets[index];
+				}
+			}
+		}
+
+		template<typename Type, typename... Others>
+		JoinView include() const
+		{
+			static_assert((!ComponentRegistry<Type>::sparse && ... && !ComponentRegistry<Others>::sparse), "Sparse components are filtered by joining them");
+
+			JoinView out{ *this };
+			out._include |= SignatureBuilder<Type, Others...>{};
+			out.located = true;
+			return out;
+		}
+
+		template<typename Type, typename... Others>
+		JoinView exclude() const
+		{
+			static_assert((!ComponentRegistry<Type>::sparse && ... && !ComponentRegistry<Others>::sparse), "Sparse components are filtered by joining them");
+
+			JoinView out{ *this };
+			out._exclude |= SignatureBuilder<Type, Others...>{};
+			out.located = true;
+			return out;
+		}
+
+		template<typename Callable>
+		void each(const Callable& callable)
+		{
+			for (size_t index{ next(0) }; index < size(); index = next(index + 1))
+			{
+				std::apply(callable, group(index));
+			}
 		}
 
 		iterator begin()
 		{
-			return iterator{ 0,clusters,0 };
+			return iterator{ *this, 0 };
 		}
 
 		iterator end()
 		{
-			return iterator{ 0, clusters, clusters.size() };
+			return iterator{ *this, size() };
+		}
+
+	private:
+		size_t size() const
+		{
+			return driver ? driver->size() : 0;
+		}
+
+		size_t next(size_t index) const
+		{
+			while (index < size() && !accepts(driver->entities()[index]))
+			{
+				++index;
+			}
+			return std::min(index, size());
+		}
+
+		bool accepts(EntityID id) const
+		{
+			for (auto set : sets)
+			{
+				if (set && set != driver && !set->contains(id))
+				{
+					return false;
+				}
+			}
+
+			if (!located)
+			{
+				return true;
+			}
+
+			const EntityLocation& location{ (*locations)[EntityHandle::index(id)] };
+			if (!location.cluster)
+			{
+				return _include.none();
+			}
+			return location.cluster->signature().includes(_include) && !location.cluster->signature().matches(_exclude);
+		}
+
+		IDGroup group(size_t index)
+		{
+			return group(driver->entities()[index], Sequence{});
+		}
+
+		template<size_t... Indices>
+		IDGroup group(EntityID id, std::index_sequence<Indices...>)
+		{
+			const EntityLocation* location{ located ? &(*locations)[EntityHandle::index(id)] : nullptr };
+			return IDGroup(id, get<Types, Indices>(id, location)...);
+		}
+
+		template<typename Type, size_t SetIndex>
+		Type& get(EntityID id, const EntityLocation* location)
+		{
+			if constexpr (ComponentRegistry<Type>::sparse)
+			{
+				SparseSet& set{ *sets[SetIndex] };
+				if constexpr (std::is_const_v<Type>)
+				{
+					return set.template get<Type>(set.find(id));
+				}
+				else
+				{
+					return tick ? set.template get<Type>(set.find(id), tick) : set.template get<Type>(set.find(id));
+				}
+			}
+			else if constexpr (ComponentRegistry<Type>::shared)
+			{
+				static_assert(std::is_const_v<Type>, "Shared components are read-only, access them as const");
+				return *static_cast<Type*>(location->cluster->shared(ComponentRegistry<Type>::id));
+			}
+			else if constexpr (ComponentRegistry<Type>::tag)
+			{
+				static std::remove_const_t<Type> tag{};
+				return tag;
+			}
+			else if constexpr (std::is_const_v<Type>)
+			{
+				return location->cluster->template get<Type>(location->index);
+			}
+			else
+			{
+				return tick ? location->cluster->template get<Type>(location->index, tick) : location->cluster->template get<Type>(location->index);
+			}
 		}
 	};
 